@@ -81,11 +81,10 @@ namespace eosio {
 
       T inst(self, code, ds);
 
-      auto f2 = [&]( auto... a ){
-         ((&inst)->*func)( a... );
-      };
-
-      boost::mp11::tuple_apply( f2, args );
+      // hand the decoded arguments over without copying them, moved into by value parameters
+      std::apply( [&]( auto&... a ) {
+         ((&inst)->*func)( std::forward<Args>(a)... );
+      }, args );
       if ( max_stack_buffer_size < size ) {
          free(buffer);
       }
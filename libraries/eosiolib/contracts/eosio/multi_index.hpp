@@ -11,7 +11,9 @@
 
 #include <vector>
 #include <tuple>
+#include <string_view>
 #include <boost/hana.hpp>
+#include <boost/pfr.hpp>
 #include <functional>
 #include <utility>
 #include <type_traits>
@@ -330,6 +332,270 @@ namespace _multi_index_detail {
       static constexpr eosio::fixed_bytes<32> true_lowest() { return eosio::fixed_bytes<32>(); }
    };
 
+   /**
+    * Read-only view over a packed array of primitive values.
+    * Elements are copied out of the underlying bytes on access, so the bytes do not need to be aligned.
+    */
+   template<typename T>
+   class packed_array_view {
+      public:
+         packed_array_view() = default;
+         packed_array_view( const char* data, size_t size )
+         :_data(data),_size(size){}
+
+         T operator[]( size_t i )const {
+            T v;
+            memcpy( &v, _data + i * sizeof(T), sizeof(T) );
+            return v;
+         }
+
+         T at( size_t i )const {
+            eosio::check( i < _size, "packed_array_view index out of range" );
+            return (*this)[i];
+         }
+
+         const char* data()const { return _data; }
+         size_t      size()const { return _size; }
+         bool        empty()const { return _size == 0; }
+
+      private:
+         const char* _data = nullptr;
+         size_t      _size = 0;
+   };
+
+   template<typename T>
+   struct is_primitive_vector : std::false_type {};
+
+   template<typename T>
+   struct is_primitive_vector<std::vector<T>> : std::bool_constant<_datastream_detail::is_primitive<T>()> {};
+
+   /// Type returned by a row view for a field of type F, variable-length fields are views into the row bytes
+   template<typename F>
+   struct field_view { using type = F; };
+
+   template<>
+   struct field_view<std::string> { using type = std::string_view; };
+
+   template<typename T>
+   struct field_view<std::vector<T>> {
+      using type = std::conditional_t<_datastream_detail::is_primitive<T>(), packed_array_view<T>, std::vector<T>>;
+   };
+
+   template<typename F>
+   using field_view_type = typename field_view<F>::type;
+
+   template<typename F>
+   field_view_type<F> read_field_view( datastream<const char*>& ds ) {
+      if constexpr( std::is_same_v<F, std::string> || is_primitive_vector<F>::value ) {
+         unsigned_int s;
+         ds >> s;
+         eosio::check( s.value <= ds.remaining() / sizeof(typename F::value_type), "read" );
+         const char* data = ds.pos();
+         ds.skip( s.value * sizeof(typename F::value_type) );
+         return { data, s.value };
+      } else {
+         F v;
+         ds >> v;
+         return v;
+      }
+   }
+
+   template<typename F>
+   void skip_field( datastream<const char*>& ds ) {
+      _datastream_detail::skip_packed<F>( ds );
+   }
+
+   /**
+    * Per-instance cache of the rows loaded by a multi_index.
+    *
+    * Rows are owned through `std::unique_ptr` so their addresses never change while they are cached.
+    * Two open-addressing (linear probing) hash tables index the rows by primary key and by primary
+    * iterator, which keeps lookups constant time regardless of how many rows an action touches.
+    * Each hash slot stores `entry index + 1`, with 0 marking an empty slot.
+    *
+    * Rows inserted in bulk may instead be constructed inside a block obtained from `allocate_block`,
+    * in which case only their destructor runs on erase and the block is released with the cache.
+    */
+   template<typename Item>
+   class row_cache {
+      public:
+         struct item_deleter {
+            item_deleter( bool pooled = false ) : _pooled(pooled) {}
+            item_deleter( std::default_delete<Item> ) {}
+
+            void operator()( Item* i )const {
+               if( _pooled )
+                  i->~Item();
+               else
+                  delete i;
+            }
+
+            bool _pooled = false;
+         };
+
+         typedef std::unique_ptr<Item, item_deleter> item_ptr;
+
+         row_cache() = default;
+         row_cache( row_cache&& ) = default;
+
+         /**
+          * Destroys the cached rows before the blocks they may have been constructed in are released,
+          * which the memberwise assignment would do the other way around.
+          */
+         row_cache& operator=( row_cache&& other ) {
+            if( this != &other ) {
+               _entries.clear();
+               _by_primary_key.clear();
+               _by_primary_itr.clear();
+               _blocks         = std::move(other._blocks);
+               _entries        = std::move(other._entries);
+               _by_primary_key = std::move(other._by_primary_key);
+               _by_primary_itr = std::move(other._by_primary_itr);
+            }
+            return *this;
+         }
+
+         struct entry {
+            entry( item_ptr&& i, uint64_t pk, int32_t pitr )
+            : _item(std::move(i)), _primary_key(pk), _primary_itr(pitr) {}
+
+            item_ptr _item;
+            uint64_t _primary_key;
+            int32_t  _primary_itr;
+         };
+
+         /**
+          * Returns uninitialized storage for `n` rows, to be constructed with placement new and
+          * inserted as `item_ptr( ptr, item_deleter(true) )`.
+          */
+         Item* allocate_block( size_t n ) {
+            static_assert( alignof(Item) <= alignof(std::max_align_t), "row type is over-aligned" );
+            _blocks.emplace_back( new char[n * sizeof(Item)] );
+            return reinterpret_cast<Item*>( _blocks.back().get() );
+         }
+
+         Item* find_by_primary_key( uint64_t pk )const {
+            auto slot = _by_primary_key.empty() ? 0 : _by_primary_key[probe_primary_key( pk )];
+            return slot ? _entries[slot-1]._item.get() : nullptr;
+         }
+
+         Item* find_by_primary_iterator( int32_t itr )const {
+            auto slot = _by_primary_itr.empty() ? 0 : _by_primary_itr[probe_primary_itr( itr )];
+            return slot ? _entries[slot-1]._item.get() : nullptr;
+         }
+
+         /**
+          * Caches a row, which must not be cached yet under its primary key or its primary iterator
+          */
+         Item& insert( item_ptr&& i, uint64_t pk, int32_t pitr ) {
+            if( (_entries.size() + 1) * 2 > _by_primary_key.size() )
+               rehash( _by_primary_key.empty() ? min_buckets : _by_primary_key.size() * 2 );
+
+            auto pk_bucket  = probe_primary_key( pk );
+            auto itr_bucket = probe_primary_itr( pitr );
+            eosio::check( !_by_primary_key[pk_bucket] && !_by_primary_itr[itr_bucket], "row is already cached" );
+
+            _entries.emplace_back( std::move(i), pk, pitr );
+            uint32_t slot = uint32_t(_entries.size());
+            _by_primary_key[pk_bucket]  = slot;
+            _by_primary_itr[itr_bucket] = slot;
+            return *_entries.back()._item;
+         }
+
+         /**
+          * Removes the row with the given primary key, returns false if it was not cached.
+          * The last entry is moved into the freed position, so no other row is reallocated.
+          */
+         bool erase( uint64_t pk ) {
+            if( _by_primary_key.empty() )
+               return false;
+
+            auto pk_bucket = probe_primary_key( pk );
+            auto slot = _by_primary_key[pk_bucket];
+            if( !slot )
+               return false;
+
+            auto& e = _entries[slot-1];
+            remove_bucket( _by_primary_key, pk_bucket, [&]( uint32_t s ) { return bucket_for( _entries[s-1]._primary_key ); } );
+            remove_bucket( _by_primary_itr, probe_primary_itr( e._primary_itr ), [&]( uint32_t s ) { return bucket_for( itr_key( _entries[s-1]._primary_itr ) ); } );
+
+            if( slot != _entries.size() ) {
+               auto& last = _entries.back();
+               _by_primary_key[probe_primary_key( last._primary_key )]   = slot;
+               _by_primary_itr[probe_primary_itr( last._primary_itr )] = slot;
+               e = std::move(last);
+            }
+            _entries.pop_back();
+            return true;
+         }
+
+         size_t size()const { return _entries.size(); }
+
+         template<typename F>
+         void for_each( F&& f )const {
+            for( const auto& e : _entries )
+               f( *e._item );
+         }
+
+      private:
+         static constexpr size_t min_buckets = 16;
+
+         static uint64_t itr_key( int32_t itr ) { return uint32_t(itr); }
+
+         size_t bucket_for( uint64_t key )const {
+            // Fibonacci hashing, the table size is always a power of two
+            return size_t((key * 0x9E3779B97F4A7C15ULL) >> 32) & (_by_primary_key.size() - 1);
+         }
+
+         template<typename Match>
+         size_t probe( const std::vector<uint32_t>& buckets, uint64_t key, Match&& match )const {
+            auto mask = buckets.size() - 1;
+            for( auto b = bucket_for( key );; b = (b + 1) & mask ) {
+               auto slot = buckets[b];
+               if( !slot || match( _entries[slot-1] ) )
+                  return b;
+            }
+         }
+
+         size_t probe_primary_key( uint64_t pk )const {
+            return probe( _by_primary_key, pk, [&]( const entry& e ) { return e._primary_key == pk; } );
+         }
+
+         size_t probe_primary_itr( int32_t itr )const {
+            return probe( _by_primary_itr, itr_key( itr ), [&]( const entry& e ) { return e._primary_itr == itr; } );
+         }
+
+         /// backward shift deletion, keeps every probe sequence contiguous without tombstones
+         template<typename HomeOf>
+         static void remove_bucket( std::vector<uint32_t>& buckets, size_t hole, HomeOf&& home_of ) {
+            auto mask = buckets.size() - 1;
+            for( auto b = (hole + 1) & mask; buckets[b]; b = (b + 1) & mask ) {
+               auto home = home_of( buckets[b] );
+               if( ((b - home) & mask) >= ((b - hole) & mask) ) {
+                  buckets[hole] = buckets[b];
+                  hole = b;
+               }
+            }
+            buckets[hole] = 0;
+         }
+
+         void rehash( size_t n ) {
+            _by_primary_key.assign( n, 0 );
+            _by_primary_itr.assign( n, 0 );
+            for( uint32_t s = 1; s <= _entries.size(); ++s ) {
+               const auto& e = _entries[s-1];
+               _by_primary_key[probe_primary_key( e._primary_key )]   = s;
+               _by_primary_itr[probe_primary_itr( e._primary_itr )] = s;
+            }
+         }
+
+         // declared before _entries so that pooled rows are destroyed before their storage, see also operator=
+         std::vector<std::unique_ptr<char[]>> _blocks;
+         std::vector<entry>    _entries;
+         std::vector<uint32_t> _by_primary_key;
+         std::vector<uint32_t> _by_primary_itr;
+   };
+
 }
 
 /**
@@ -453,6 +719,8 @@ class multi_index
          unset_next_primary_key = static_cast<uint64_t>(-1)
       };
 
+      typedef std::tuple<typename std::decay<decltype( typename Indices::secondary_extractor_type()(std::declval<const T&>()) )>::type...> secondary_keys_type;
+
       struct item : public T
       {
          template<typename Constructor>
@@ -464,19 +732,23 @@ class multi_index
          const multi_index* __idx;
          int32_t            __primary_itr;
          int32_t            __iters[sizeof...(Indices)+(sizeof...(Indices)==0)];
+         int32_t            __deferred = -1; // position in _deferred_rows while the row has unwritten changes
       };
 
-      struct item_ptr
-      {
-         item_ptr(std::unique_ptr<item>&& i, uint64_t pk, int32_t pitr)
-         : _item(std::move(i)), _primary_key(pk), _primary_itr(pitr) {}
-
-         std::unique_ptr<item> _item;
-         uint64_t              _primary_key;
-         int32_t               _primary_itr;
+      /// Write state of a row modified in deferred mode, see multi_index::defer_writes
+      struct deferred_row {
+         item*               row;          // null once the row is erased
+         uint64_t            payer;
+         secondary_keys_type flushed_keys; // secondary keys as last written
       };
 
-      mutable std::vector<item_ptr> _items_vector;
+      mutable _multi_index_detail::row_cache<item> _items_cache;
+
+      bool                              _deferred_writes = false;
+      mutable std::vector<deferred_row> _deferred_rows; // only allocated once a row is deferred
+
+      mutable std::vector<char> _pack_buffer; // scratch buffer every row write is serialized into
+      mutable std::vector<char> _view_buffer; // scratch buffer of the row views returned by find_view and get_view
 
       template<name::raw IndexName, typename Extractor, uint64_t Number, bool IsConst>
       struct index {
@@ -529,6 +801,7 @@ class multi_index
                      using namespace _multi_index_detail;
 
                      eosio::check( _item != nullptr, "cannot increment end iterator" );
+                     _idx->_multidx->flush_dirty_rows();
 
                      if( _item->__iters[Number] == -1 ) {
                         secondary_key_type temp_secondary_key;
@@ -557,6 +830,7 @@ class multi_index
 
                      uint64_t prev_pk = 0;
                      int32_t  prev_itr = -1;
+                     _idx->_multidx->flush_dirty_rows();
 
                      if( !_item ) {
                         auto ei = secondary_index_db_functions<secondary_key_type>::db_idx_end(_idx->get_code().value, _idx->get_scope(), _idx->name());
@@ -653,6 +927,7 @@ class multi_index
 
                uint64_t primary = 0;
                secondary_key_type secondary_copy(secondary);
+               _multidx->flush_dirty_rows();
                auto itr = secondary_index_db_functions<secondary_key_type>::db_idx_lowerbound( get_code().value, get_scope(), name(), secondary_copy, primary );
                if( itr < 0 ) return cend();
 
@@ -671,6 +946,7 @@ class multi_index
 
                uint64_t primary = 0;
                secondary_key_type secondary_copy(secondary);
+               _multidx->flush_dirty_rows();
                auto itr = secondary_index_db_functions<secondary_key_type>::db_idx_upperbound( get_code().value, get_scope(), name(), secondary_copy, primary );
                if( itr < 0 ) return cend();
 
@@ -681,11 +957,159 @@ class multi_index
                return {this, &mi};
             }
 
+            /**
+             *  Entry of a `key_range`, read from the secondary index alone.
+             *
+             *  The primary key comes with every step of the index. The secondary key is only known for the first
+             *  entry of a range: for the others, the first call to `secondary_key()` costs an extra
+             *  `db_idx*_find_primary`. The row itself is only loaded when `row()` is called.
+             */
+            class key_entry {
+               public:
+                  uint64_t primary_key()const { return _primary; }
+
+                  const secondary_key_type& secondary_key()const {
+                     using namespace _multi_index_detail;
+
+                     if( !_has_secondary ) {
+                        secondary_index_db_functions<secondary_key_type>::db_idx_find_primary( _idx->get_code().value, _idx->get_scope(), _idx->name(), _primary, _secondary );
+                        _has_secondary = true;
+                     }
+                     return _secondary;
+                  }
+
+                  const T& row()const {
+                     const T& obj = *_idx->_multidx->find( _primary );
+                     auto& mi = const_cast<item&>( static_cast<const item&>(obj) );
+                     mi.__iters[Number] = _itr;
+                     return obj;
+                  }
+
+               private:
+                  friend struct index;
+                  friend class key_range;
+
+                  const index*               _idx = nullptr;
+                  int32_t                    _itr = -1;
+                  uint64_t                   _primary = 0;
+                  mutable secondary_key_type _secondary;
+                  mutable bool               _has_secondary = false;
+            };
+
+            /**
+             *  Forward range of (secondary key, primary key) entries returned by `keys()`.
+             *
+             *  Advancing only calls `db_idx*_next`, without looking up or reading the primary rows. Reading the
+             *  secondary key of an entry costs an extra `db_idx*_find_primary`, see `key_entry`.
+             */
+            class key_range {
+               public:
+                  struct iterator : public std::iterator<std::forward_iterator_tag, const key_entry> {
+                     bool operator == ( const iterator& b )const {
+                        return key_range::index_itr( _entry ) == key_range::index_itr( b._entry );
+                     }
+                     bool operator != ( const iterator& b )const {
+                        return !(*this == b);
+                     }
+
+                     const key_entry& operator*()const { return _entry; }
+                     const key_entry* operator->()const { return &_entry; }
+
+                     iterator& operator++() {
+                        eosio::check( key_range::index_itr( _entry ) != _end, "cannot increment end iterator" );
+                        key_range::advance( _entry );
+                        return *this;
+                     }
+
+                     iterator operator++(int) {
+                        iterator result(*this);
+                        ++(*this);
+                        return result;
+                     }
+
+                     private:
+                        friend class key_range;
+                        iterator( const key_entry& e, int32_t end )
+                        :_entry(e),_end(end){}
+
+                        key_entry _entry;
+                        int32_t   _end;
+                  };
+
+                  iterator begin()const { return {_first, _end}; }
+                  iterator end()const {
+                     key_entry e;
+                     e._idx = _first._idx;
+                     e._itr = _end;
+                     return {e, _end};
+                  }
+
+               private:
+                  friend struct index;
+
+                  static int32_t index_itr( const key_entry& e ) { return e._itr; }
+
+                  static void advance( key_entry& e ) {
+                     using namespace _multi_index_detail;
+
+                     e._itr = secondary_index_db_functions<secondary_key_type>::db_idx_next( e._itr, &e._primary );
+                     e._has_secondary = false;
+                  }
+
+                  key_range( const key_entry& first, int32_t end )
+                  :_first(first),_end(end){}
+
+                  key_entry _first;
+                  int32_t   _end;
+            };
+
+            /**
+             *  Returns a range over the entries of the index whose secondary key lies in `[lo, hi]`, in index order.
+             *
+             *  @param lo - Lowest secondary key included in the range
+             *  @param hi - Highest secondary key included in the range
+             */
+            key_range keys( const secondary_key_type& lo, const secondary_key_type& hi )const {
+               using namespace _multi_index_detail;
+
+               eosio::check( !(hi < lo), "invalid secondary key range" );
+
+               uint64_t primary = 0;
+               secondary_key_type hi_copy(hi);
+               _multidx->flush_dirty_rows();
+               auto end = secondary_index_db_functions<secondary_key_type>::db_idx_upperbound( get_code().value, get_scope(), name(), hi_copy, primary );
+               return key_range( first_key_entry( lo ), end );
+            }
+
+            /// Returns a range over all the entries of the index, in index order
+            key_range keys()const {
+               using namespace _multi_index_detail;
+
+               _multidx->flush_dirty_rows();
+               auto end = secondary_index_db_functions<secondary_key_type>::db_idx_end( get_code().value, get_scope(), name() );
+               return key_range( first_key_entry( secondary_key_traits<secondary_key_type>::true_lowest() ), end );
+            }
+
+            /**
+             *  Counts the entries of the index whose secondary key lies in `[lo, hi]` without reading any row.
+             *
+             *  @param lo - Lowest secondary key included in the count
+             *  @param hi - Highest secondary key included in the count
+             */
+            size_t count_range( const secondary_key_type& lo, const secondary_key_type& hi )const {
+               auto range = keys( lo, hi );
+               size_t count = 0;
+               for( auto itr = range.begin(), e = range.end(); itr != e; ++itr )
+                  ++count;
+               return count;
+            }
+
             const_iterator iterator_to( const T& obj ) {
                using namespace _multi_index_detail;
 
                const auto& objitem = static_cast<const item&>(obj);
                eosio::check( objitem.__idx == _multidx, "object passed to iterator_to is not in multi_index" );
+               _multidx->flush_dirty_rows();
 
                if( objitem.__iters[Number] == -1 ) {
                   secondary_key_type temp_secondary_key;
@@ -723,6 +1147,17 @@ class multi_index
          private:
             friend class multi_index;
 
+            key_entry first_key_entry( const secondary_key_type& lo )const {
+               using namespace _multi_index_detail;
+
+               key_entry e;
+               e._idx = this;
+               e._secondary = lo;
+               e._itr = secondary_index_db_functions<secondary_key_type>::db_idx_lowerbound( get_code().value, get_scope(), name(), e._secondary, e._primary );
+               e._has_secondary = e._itr >= 0;
+               return e;
+            }
+
             index( typename std::conditional<IsConst, const multi_index*, multi_index*>::type midx )
             :_multidx(midx){}
 
@@ -761,11 +1196,8 @@ class multi_index
       const item& load_object_by_primary_iterator( int32_t itr )const {
          using namespace _multi_index_detail;
 
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._primary_itr == itr;
-         });
-         if( itr2 != _items_vector.rend() )
-            return *itr2->_item;
+         if( const item* cached = _items_cache.find_by_primary_iterator( itr ) )
+            return *cached;
 
          auto size = internal_use_do_not_use::db_get_i64( itr, nullptr, 0 );
          eosio::check( size >= 0, "error reading iterator" );
@@ -775,11 +1207,9 @@ class multi_index
 
          internal_use_do_not_use::db_get_i64( itr, buffer, uint32_t(size) );
 
-         datastream<const char*> ds( (char*)buffer, uint32_t(size) );
-
          auto itm = std::make_unique<item>( this, [&]( auto& i ) {
             T& val = static_cast<T&>(i);
-            ds >> val;
+            _datastream_detail::unpack_into( val, (const char*)buffer, size_t(size) );
 
             i.__primary_itr = itr;
             hana::for_each( _indices, [&]( auto& idx ) {
@@ -793,7 +1223,7 @@ class multi_index
          auto pk   = itm->primary_key();
          auto pitr = itm->__primary_itr;
 
-         _items_vector.emplace_back( std::move(itm), pk, pitr );
+         _items_cache.insert( std::move(itm), pk, pitr );
 
          if ( max_stack_buffer_size < size_t(size) ) {
             free(buffer);
@@ -802,6 +1232,80 @@ class multi_index
          return *ptr;
       } /// load_object_by_primary_iterator
 
+      /// Stores a packed row and its secondary keys, recording the resulting iterators in the item
+      void store_item( item& i, name payer, const void* buffer, size_t size ) {
+         using namespace _multi_index_detail;
+
+         const T& obj = static_cast<const T&>(i);
+         auto pk = obj.primary_key();
+
+         i.__primary_itr = internal_use_do_not_use::db_store_i64( _scope, static_cast<uint64_t>(TableName), payer.value, pk, buffer, size );
+
+         if( pk >= _next_primary_key )
+            _next_primary_key = (pk >= no_available_primary_key) ? no_available_primary_key : (pk + 1);
+
+         hana::for_each( _indices, [&]( auto& idx ) {
+            typedef typename decltype(+hana::at_c<0>(idx))::type index_type;
+
+            i.__iters[index_type::number()] = secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_store( _scope, index_type::name(), payer.value, pk, index_type::extract_secondary_key(obj) );
+         });
+      }
+
+      /// Serializes a row in a single pass into the scratch buffer, which stays valid until the next row is packed
+      const std::vector<char>& pack_row( const T& obj )const {
+         _pack_buffer.clear();
+         _datastream_detail::pack_append( _pack_buffer, obj );
+         return _pack_buffer;
+      }
+
+      static secondary_keys_type extract_secondary_keys( const T& obj ) {
+         return secondary_keys_type{ typename Indices::secondary_extractor_type()(obj)... };
+      }
+
+      /// Writes a row modified in deferred mode, updating only the secondary keys that changed since the last write
+      void flush_row( const deferred_row& d )const {
+         using namespace _multi_index_detail;
+
+         item& i = *d.row;
+         const T& obj = static_cast<const T&>(i);
+         const auto& packed = pack_row( obj );
+         internal_use_do_not_use::db_update_i64( i.__primary_itr, d.payer, packed.data(), packed.size() );
+
+         hana::for_each( _indices, [&]( auto& idx ) {
+            typedef typename decltype(+hana::at_c<0>(idx))::type index_type;
+
+            auto secondary = index_type::extract_secondary_key( obj );
+            if( memcmp( &std::get<index_type::index_number>(d.flushed_keys), &secondary, sizeof(secondary) ) != 0 ) {
+               auto indexitr = i.__iters[index_type::number()];
+
+               if( indexitr < 0 ) {
+                  typename index_type::secondary_key_type temp_secondary_key;
+                  indexitr = i.__iters[index_type::number()]
+                           = secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_find_primary( _code.value, _scope, index_type::name(), obj.primary_key(), temp_secondary_key );
+               }
+
+               secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_update( indexitr, d.payer, secondary );
+            }
+         });
+
+         i.__deferred = -1;
+      }
+
+      void flush_dirty_rows()const {
+         if( _deferred_rows.empty() )
+            return;
+
+         for( const auto& d : _deferred_rows )
+            if( d.row )
+               flush_row( d );
+         _deferred_rows.clear();
+      }
+
+      /// Points the rows moved in from another table at this one
+      void adopt_cached_rows() {
+         _items_cache.for_each( [&]( item& i ) { i.__idx = this; } );
+      }
+
    public:
       /**
        *  Constructs an instance of a Multi-Index table.
@@ -854,6 +1358,99 @@ class multi_index
       :_code(code),_scope(scope),_next_primary_key(unset_next_primary_key)
       {}
 
+      /**
+       *  Moves the table and its cached rows, which keep their addresses. The moved-from table is left empty.
+       *  @ingroup multiindex
+       */
+      multi_index( multi_index&& other )
+      :_code(other._code),_scope(other._scope),_next_primary_key(other._next_primary_key),
+       _items_cache(std::move(other._items_cache)),_deferred_writes(other._deferred_writes),
+       _deferred_rows(std::move(other._deferred_rows)),_pack_buffer(std::move(other._pack_buffer)),
+       _view_buffer(std::move(other._view_buffer))
+      {
+         adopt_cached_rows();
+      }
+
+      /**
+       *  Writes the rows still pending in this table, then moves `other` into it.
+       *  @ingroup multiindex
+       */
+      multi_index& operator=( multi_index&& other ) {
+         if( this != &other ) {
+            flush_dirty_rows();
+            _code             = other._code;
+            _scope            = other._scope;
+            _next_primary_key = other._next_primary_key;
+            _items_cache      = std::move(other._items_cache);
+            _deferred_writes  = other._deferred_writes;
+            _deferred_rows    = std::move(other._deferred_rows);
+            _pack_buffer      = std::move(other._pack_buffer);
+            _view_buffer      = std::move(other._view_buffer);
+            adopt_cached_rows();
+         }
+         return *this;
+      }
+
+      /**
+       *  Writes any rows still pending from deferred mode.
+       *  @ingroup multiindex
+       */
+      ~multi_index() {
+         flush_dirty_rows();
+      }
+
+      /**
+       *  Enables or disables deferred writes for this instance of the table.
+       *  @ingroup multiindex
+       *
+       *  While deferred writes are enabled, `modify` only updates the cached row and marks it dirty. Dirty rows are
+       *  serialized and written once, together with the net change of each secondary key, when `flush()` is called,
+       *  when a secondary index of the table is accessed, or when the table object is destroyed. Rows modified
+       *  several times in one action are therefore packed and written only once. Disabling deferred writes flushes
+       *  the pending rows.
+       *
+       *  Until they are flushed, pending changes are only visible through this instance: other `multi_index` objects
+       *  over the same table, and direct `db_*` reads, see the rows as they were last written.
+       *
+       *  @param enabled - Whether `modify` should defer writes
+       *
+       *  Example:
+       *
+       *  @code
+       *  // This assumes the code from the constructor example. Replace myaction() {...}
+       *
+       *      void myaction() {
+       *        addresses.defer_writes();
+       *        const auto& dan = addresses.get("dan"_n.value);
+       *        for( int i = 0; i < 10; ++i ) {
+       *          addresses.modify(dan, same_payer, [&](auto& address) { address.zip += 1; });
+       *        }
+       *        addresses.flush(); // optional, the destructor flushes as well
+       *      }
+       *  }
+       *  EOSIO_DISPATCH( addressbook, (myaction) )
+       *  @endcode
+       */
+      void defer_writes( bool enabled = true ) {
+         if( !enabled )
+            flush_dirty_rows();
+         _deferred_writes = enabled;
+      }
+
+      /**
+       *  Returns whether `modify` defers writes for this instance of the table.
+       *  @ingroup multiindex
+       */
+      bool deferred_writes()const { return _deferred_writes; }
+
+      /**
+       *  Writes every row modified in deferred mode since the last flush.
+       *  @ingroup multiindex
+       */
+      void flush() {
+         flush_dirty_rows();
+      }
+
       /**
        *  Returns the `code` member property.
        *  @ingroup multiindex
@@ -1289,6 +1886,132 @@ class multi_index
          return {this, &obj};
       }
 
+      /**
+       *  Forward-only range over the rows of the table returned by `scan()`.
+       *  @ingroup multiindex
+       *
+       *  Rows are decoded into a single row slot owned by the range, reusing one read buffer, and are not added to the
+       *  row cache of the table. A reference obtained from the range is only valid until the range is advanced.
+       *  Rows already cached by the table (e.g. through `find` or `emplace`) are yielded from the cache instead.
+       */
+      class scan_range {
+         public:
+            struct iterator : public std::iterator<std::input_iterator_tag, const T> {
+               friend bool operator == ( const iterator& a, const iterator& b ) {
+                  return a._itr == b._itr;
+               }
+               friend bool operator != ( const iterator& a, const iterator& b ) {
+                  return a._itr != b._itr;
+               }
+
+               const T& operator*()const { return *_range->_current; }
+               const T* operator->()const { return _range->_current; }
+
+               iterator& operator++() {
+                  eosio::check( _itr >= 0, "cannot increment end iterator" );
+                  _itr = _range->advance( _itr );
+                  return *this;
+               }
+
+               private:
+                  friend class scan_range;
+                  iterator( scan_range* r, int32_t itr )
+                  :_range(r),_itr(itr){}
+
+                  scan_range* _range;
+                  int32_t     _itr;
+            };
+
+            scan_range( const scan_range& ) = delete;
+            scan_range& operator=( const scan_range& ) = delete;
+
+            /// Starts the scan, can only be called once per range
+            iterator begin() {
+               eosio::check( !_started, "scan_range can only be iterated once" );
+               _started = true;
+               auto itr = internal_use_do_not_use::db_lowerbound_i64( _multidx->_code.value, _multidx->_scope, static_cast<uint64_t>(TableName), _lo );
+               return {this, load( itr )};
+            }
+            iterator end() { return {this, -1}; }
+
+         private:
+            friend class multi_index;
+
+            scan_range( const multi_index* mi, uint64_t lo, uint64_t hi )
+            :_multidx(mi),_lo(lo),_hi(hi),_row(nullptr, []( auto& ){}){}
+
+            int32_t advance( int32_t itr ) {
+               if( _current_pk == _hi )
+                  return -1;
+               uint64_t next_pk;
+               return load( internal_use_do_not_use::db_next_i64( itr, &next_pk ) );
+            }
+
+            int32_t load( int32_t itr ) {
+               if( itr < 0 )
+                  return -1;
+
+               if( const item* cached = _multidx->_items_cache.find_by_primary_iterator( itr ) ) {
+                  _current    = cached;
+                  _current_pk = cached->primary_key();
+               } else {
+                  auto size = internal_use_do_not_use::db_get_i64( itr, nullptr, 0 );
+                  eosio::check( size >= 0, "error reading iterator" );
+                  if( _buffer.size() < size_t(size) )
+                     _buffer.resize( size_t(size) );
+                  internal_use_do_not_use::db_get_i64( itr, _buffer.data(), uint32_t(size) );
+
+                  _datastream_detail::unpack_into( static_cast<T&>(_row), _buffer.data(), size_t(size) );
+                  _current    = &_row;
+                  _current_pk = _row.primary_key();
+               }
+               return _current_pk > _hi ? -1 : itr;
+            }
+
+            const multi_index* _multidx;
+            uint64_t           _lo;
+            uint64_t           _hi;
+            bool               _started = false;
+            uint64_t           _current_pk = 0;
+            const T*           _current = nullptr;
+            item               _row; // belongs to no table, so modify and erase reject it
+            std::vector<char>  _buffer;
+      }; /// class multi_index::scan_range
+
+      /**
+       *  Returns a forward-only range over the rows whose primary key lies in `[lo, hi]`, in primary key order.
+       *  @ingroup multiindex
+       *
+       *  Unlike iterating with `begin()`/`end()`, visited rows are not kept in the row cache, so a full table scan
+       *  uses memory proportional to the largest row rather than to the size of the table.
+       *
+       *  Rows that were not cached yet cannot be passed to `modify`, `erase` or `iterator_to`, which fail with
+       *  "object passed to ... is not in multi_index"; look such a row up with `find` first. Rows already cached
+       *  are yielded from the cache, so changes made through the table while the scan runs are visible to it.
+       *
+       *  @param lo - Lowest primary key included in the scan
+       *  @param hi - Highest primary key included in the scan
+       *  @return A `scan_range` that can be iterated once.
+       *
+       *  Example:
+       *
+       *  @code
+       *  // This assumes the code from the constructor example. Replace myaction() {...}
+       *
+       *      void myaction() {
+       *        uint64_t total_zip = 0;
+       *        for( const auto& address : addresses.scan() ) {
+       *          total_zip += address.zip;
+       *        }
+       *      }
+       *  }
+       *  EOSIO_DISPATCH( addressbook, (myaction) )
+       *  @endcode
+       */
+      scan_range scan( uint64_t lo = std::numeric_limits<uint64_t>::lowest(), uint64_t hi = std::numeric_limits<uint64_t>::max() )const {
+         return {this, lo, hi};
+      }
+
       /**
        *  Returns an available primary key.
        *  @ingroup multiindex
@@ -1531,39 +2254,70 @@ class multi_index
             T& obj = static_cast<T&>(i);
             constructor( obj );
 
-            size_t size = pack_size( obj );
+            const auto& packed = pack_row( obj );
+            store_item( i, payer, packed.data(), packed.size() );
+         });
 
-            //using malloc/free here potentially is not exception-safe, although WASM doesn't support exceptions
-            void* buffer = max_stack_buffer_size < size ? malloc(size) : alloca(size);
+         const item* ptr = itm.get();
+         auto pk   = itm->primary_key();
+         auto pitr = itm->__primary_itr;
 
-            datastream<char*> ds( (char*)buffer, size );
-            ds << obj;
+         _items_cache.insert( std::move(itm), pk, pitr );
 
-            auto pk = obj.primary_key();
+         return {this, ptr};
+      }
 
-            i.__primary_itr = internal_use_do_not_use::db_store_i64( _scope, static_cast<uint64_t>(TableName), payer.value, pk, buffer, size );
+      /**
+       *  Adds one new object to the table for each element of a range.
+       *  @ingroup multiindex
+       *
+       *  Every row is serialized into the same growable scratch buffer owned by the table, and all rows are cached
+       *  in a single block of memory, so inserting many rows does not allocate once per row.
+       *
+       *  @param payer - Account name of the payer for the Storage usage of the new objects
+       *  @param range - A forward range of source elements
+       *  @param constructor - Lambda function called as `constructor(obj, element)` to initialize each new object
+       *
+       *  @pre Every object created must have a unique primary key
+       *  @post One row per element is added to the table, in the order of the range
+       *
+       *  Example:
+       *
+       *  @code
+       *  // This assumes the code from the constructor example. Replace myaction() {...}
+       *
+       *      void myaction(const std::vector<name>& accounts) {
+       *        addresses.emplace_many(_self, accounts, [&](auto& address, const name& account) {
+       *          address.account_name = account.value;
+       *        });
+       *      }
+       *  }
+       *  EOSIO_DISPATCH( addressbook, (myaction) )
+       *  @endcode
+       */
+      template<typename Range, typename Lambda>
+      void emplace_many( name payer, const Range& range, Lambda&& constructor ) {
+         using std::begin;
+         using std::end;
 
-            if ( max_stack_buffer_size < size ) {
-               free(buffer);
-            }
+         eosio::check( _code == current_receiver(), "cannot create objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
-            if( pk >= _next_primary_key )
-               _next_primary_key = (pk >= no_available_primary_key) ? no_available_primary_key : (pk + 1);
+         auto count = std::distance( begin(range), end(range) );
+         if( count <= 0 )
+            return;
 
-            hana::for_each( _indices, [&]( auto& idx ) {
-               typedef typename decltype(+hana::at_c<0>(idx))::type index_type;
+         item* storage = _items_cache.allocate_block( size_t(count) );
+         for( const auto& element : range ) {
+            item* i = new (storage++) item( this, [&]( auto& i ) {
+               T& obj = static_cast<T&>(i);
+               constructor( obj, element );
 
-               i.__iters[index_type::number()] = secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_store( _scope, index_type::name(), payer.value, obj.primary_key(), index_type::extract_secondary_key(obj) );
+               const auto& packed = pack_row( obj );
+               store_item( i, payer, packed.data(), packed.size() );
             });
-         });
 
-         const item* ptr = itm.get();
-         auto pk   = itm->primary_key();
-         auto pitr = itm->__primary_itr;
-
-         _items_vector.emplace_back( std::move(itm), pk, pitr );
-
-         return {this, ptr};
+            _items_cache.insert( typename _multi_index_detail::row_cache<item>::item_ptr( i, true ), i->primary_key(), i->__primary_itr );
+         }
       }
 
       /**
@@ -1663,6 +2417,20 @@ class multi_index
          auto& mutableitem = const_cast<item&>(objitem);
          eosio::check( _code == current_receiver(), "cannot modify objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
+         if( _deferred_writes ) {
+            if( mutableitem.__deferred < 0 ) {
+               mutableitem.__deferred = int32_t(_deferred_rows.size());
+               _deferred_rows.push_back( { &mutableitem, 0, extract_secondary_keys( obj ) } );
+            }
+            if( payer != same_payer )
+               _deferred_rows[mutableitem.__deferred].payer = payer.value;
+
+            auto pk = obj.primary_key();
+            updater( const_cast<T&>(obj) );
+            eosio::check( pk == obj.primary_key(), "updater cannot change primary key when modifying an object" );
+            return;
+         }
+
          auto secondary_keys = hana::transform( _indices, [&]( auto&& idx ) {
             typedef typename decltype(+hana::at_c<0>(idx))::type index_type;
 
@@ -1676,18 +2444,8 @@ class multi_index
 
          eosio::check( pk == obj.primary_key(), "updater cannot change primary key when modifying an object" );
 
-         size_t size = pack_size( obj );
-         //using malloc/free here potentially is not exception-safe, although WASM doesn't support exceptions
-         void* buffer = max_stack_buffer_size < size ? malloc(size) : alloca(size);
-
-         datastream<char*> ds( (char*)buffer, size );
-         ds << obj;
-
-         internal_use_do_not_use::db_update_i64( objitem.__primary_itr, payer.value, buffer, size );
-
-         if ( max_stack_buffer_size < size ) {
-            free( buffer );
-         }
+         const auto& packed = pack_row( obj );
+         internal_use_do_not_use::db_update_i64( objitem.__primary_itr, payer.value, packed.data(), packed.size() );
 
          if( pk >= _next_primary_key )
             _next_primary_key = (pk >= no_available_primary_key) ? no_available_primary_key : (pk + 1);
@@ -1765,11 +2523,8 @@ class multi_index
        *  @endcode
        */
       const_iterator find( uint64_t primary )const {
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._item->primary_key() == primary;
-         });
-         if( itr2 != _items_vector.rend() )
-            return iterator_to(*(itr2->_item));
+         if( const item* cached = _items_cache.find_by_primary_key( primary ) )
+            return iterator_to( *cached );
 
          auto itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary );
          if( itr < 0 ) return end();
@@ -1788,11 +2543,8 @@ class multi_index
        */
 
       const_iterator require_find( uint64_t primary, const char* error_msg = "unable to find key" )const {
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-               return ptr._item->primary_key() == primary;
-            });
-         if( itr2 != _items_vector.rend() )
-            return iterator_to(*(itr2->_item));
+         if( const item* cached = _items_cache.find_by_primary_key( primary ) )
+            return iterator_to( *cached );
 
          auto itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary );
          eosio::check( itr >= 0,  error_msg );
@@ -1801,6 +2553,165 @@ class multi_index
          return iterator_to(static_cast<const T&>(i));
       }
 
+      /**
+       *  Read-only view over the packed bytes of a row, returned by `find_view()` and `get_view()`.
+       *  @ingroup multiindex
+       *
+       *  Fields are decoded on access straight from the bytes returned by `db_get_i64`, skipping the fields that
+       *  precede them. `std::string` fields are returned as `std::string_view` and vectors of primitive types as
+       *  `packed_array_view`, both pointing into the view, so neither allocates. Other fields are returned by value.
+       *
+       *  The view does not own its bytes: they live in the buffer passed to `find_view()`, or by default in a scratch
+       *  buffer of the table that the next `find_view()` or `get_view()` on the same table overwrites.
+       *
+       *  Fields are located through `boost::pfr`, so `T` must be an aggregate that serializes all of its fields in
+       *  declaration order, as `EOSLIB_SERIALIZE` does when every member is listed in order.
+       */
+      class row_view {
+         public:
+            row_view() = default;
+
+            explicit operator bool()const { return _found; }
+
+            /**
+             *  Decodes a single field of the row.
+             *
+             *  @param member - Pointer to the data member to read, e.g. `&record::balance`
+             *  @return The decoded field, or a view into the row bytes for string and primitive vector fields.
+             */
+            template<typename Field>
+            _multi_index_detail::field_view_type<Field> get( Field T::* member )const& {
+               static_assert( std::is_aggregate_v<T>, "row_view requires an aggregate row type" );
+               eosio::check( _found, "cannot read from an empty row_view" );
+
+               const T& sample = layout_sample();
+               size_t offset = (const char*)&(sample.*member) - (const char*)&sample;
+               datastream<const char*> ds( _data, _size );
+               return read_member<0, Field>( ds, sample, offset );
+            }
+
+            /// Fields may point into the view, so they cannot be read from a temporary one
+            template<typename Field>
+            void get( Field T::* member )const&& = delete;
+
+            /// Decodes the whole row
+            T unpack()const {
+               eosio::check( _found, "cannot read from an empty row_view" );
+               return eosio::unpack<T>( _data, _size );
+            }
+
+            const char* data()const { return _data; }
+            size_t      size()const { return _size; }
+
+         private:
+            friend class multi_index;
+
+            /// Default constructed row that field addresses are measured against, built once per row type and never destroyed
+            static const T& layout_sample() {
+               alignas(T) static char storage[sizeof(T)];
+               static const T* sample = new (storage) T{};
+               return *sample;
+            }
+
+            template<size_t I, typename Field>
+            static _multi_index_detail::field_view_type<Field> read_member( datastream<const char*>& ds, const T& sample, size_t offset ) {
+               using field_type = boost::pfr::tuple_element_t<I, T>;
+
+               if constexpr( std::is_same_v<field_type, Field> ) {
+                  if( size_t((const char*)&boost::pfr::get<I>(sample) - (const char*)&sample) == offset )
+                     return _multi_index_detail::read_field_view<Field>( ds );
+               }
+               _multi_index_detail::skip_field<field_type>( ds );
+
+               if constexpr( I + 1 < boost::pfr::tuple_size_v<T> ) {
+                  return read_member<I + 1, Field>( ds, sample, offset );
+               } else {
+                  eosio::check( false, "member passed to row_view::get is not a field of the row" );
+                  return {};
+               }
+            }
+
+            const char* _data  = nullptr;
+            size_t      _size  = 0;
+            bool        _found = false;
+      }; /// class multi_index::row_view
+
+      /**
+       *  Returns a read-only view over the packed bytes of the row with the given primary key, without deserializing it.
+       *  @ingroup multiindex
+       *
+       *  The row is not added to the row cache. Use this for lookups that only read a few fields of large rows.
+       *  The bytes of the row are read into a scratch buffer of the table, so the view is only valid until the next
+       *  `find_view()` or `get_view()` on this table; pass a buffer of your own to keep several views.
+       *
+       *  @param primary - Primary key value of the object
+       *  @param buffer - Buffer the bytes of the row are read into, reused across calls
+       *  @return A `row_view` of the object, which converts to false if the object was not found.
+       *
+       *  Example:
+       *
+       *  @code
+       *  // This assumes the code from the constructor example. Replace myaction() {...}
+       *
+       *      void myaction() {
+       *        auto view = addresses.find_view("dan"_n.value);
+       *        if( view ) {
+       *          std::string_view city = view.get(&address::city);
+       *          uint32_t zip = view.get(&address::zip);
+       *        }
+       *      }
+       *  }
+       *  EOSIO_DISPATCH( addressbook, (myaction) )
+       *  @endcode
+       */
+      row_view find_view( uint64_t primary, std::vector<char>& buffer )const {
+         row_view view;
+         const item* cached = _items_cache.find_by_primary_key( primary );
+         if( cached && cached->__deferred >= 0 ) {
+            buffer.clear();
+            _datastream_detail::pack_append( buffer, static_cast<const T&>(*cached) );
+            view._size = buffer.size();
+         } else {
+            auto itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary );
+            if( itr < 0 ) return view;
+
+            auto size = internal_use_do_not_use::db_get_i64( itr, nullptr, 0 );
+            eosio::check( size >= 0, "error reading iterator" );
+            if( buffer.size() < size_t(size) )
+               buffer.resize( size_t(size) );
+            internal_use_do_not_use::db_get_i64( itr, buffer.data(), uint32_t(size) );
+            view._size = size_t(size);
+         }
+         view._data  = buffer.data();
+         view._found = true;
+         return view;
+      }
+
+      row_view find_view( uint64_t primary )const {
+         return find_view( primary, _view_buffer );
+      }
+
+      /**
+       *  Returns a read-only view over the packed bytes of the row with the given primary key, and aborts if it does not exist.
+       *  @ingroup multiindex
+       *
+       *  The view is valid as long as one returned by `find_view()` with the same buffer would be.
+       *
+       *  @param primary - Primary key value of the object
+       *  @param buffer - Buffer the bytes of the row are read into, reused across calls
+       *  @param error_msg - Error message if an object with primary key `primary` is not found
+       *  @return A `row_view` of the object.
+       */
+      row_view get_view( uint64_t primary, std::vector<char>& buffer, const char* error_msg = "unable to find key" )const {
+         auto view = find_view( primary, buffer );
+         eosio::check( bool(view), error_msg );
+         return view;
+      }
+
+      row_view get_view( uint64_t primary, const char* error_msg = "unable to find key" )const {
+         return get_view( primary, _view_buffer, error_msg );
+      }
+
       /**
        *  Remove an existing object from a table using its primary key.
        *  @ingroup multiindex
@@ -1888,13 +2799,10 @@ class multi_index
          eosio::check( _code == current_receiver(), "cannot erase objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
          auto pk = objitem.primary_key();
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._item->primary_key() == pk;
-         });
+         eosio::check( _items_cache.find_by_primary_key( pk ) == &objitem, "attempt to remove object that was not in multi_index" );
 
-         eosio::check( itr2 != _items_vector.rend(), "attempt to remove object that was not in multi_index" );
-
-         _items_vector.erase(--(itr2.base()));
+         if( objitem.__deferred >= 0 )
+            _deferred_rows[objitem.__deferred].row = nullptr;
 
          internal_use_do_not_use::db_remove_i64( objitem.__primary_itr );
 
@@ -1909,6 +2817,9 @@ class multi_index
             if( i >= 0 )
                secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_remove( i );
          });
+
+         // release the row last, objitem refers to the cached storage
+         _items_cache.erase( pk );
       }
 
 };
@@ -0,0 +1,228 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace eosio {
+
+   /**
+    * @defgroup arena Arena
+    * @ingroup core
+    * @brief Bump allocated region for short lived temporaries
+    */
+
+   /**
+    * A monotonic bump region for the temporaries of an action.
+    *
+    * Memory is taken from `malloc` in blocks and handed out by bumping a pointer, individual
+    * deallocations are no-ops. The region can be rewound to an earlier mark or reset in O(1), after which
+    * the blocks it already owns are reused, so repeated batches do not keep growing the heap even when
+    * linked against the default non-freeing malloc. The blocks are returned to `malloc` by `release()` or
+    * when the arena is destroyed.
+    *
+    * @ingroup arena
+    *
+    * Example:
+    * @code
+    * eosio::arena scratch;
+    * for ( const auto& batch : batches ) {
+    *    eosio::arena_scope scope(scratch);
+    *    std::vector<uint64_t, eosio::arena_allocator<uint64_t>> ids(scratch);
+    *    ...
+    * } // everything allocated in the batch is reclaimed here
+    * @endcode
+    */
+   class arena {
+      struct block {
+         block* next;
+         size_t capacity;
+         char*  begin() { return reinterpret_cast<char*>(this + 1); }
+         char*  end() { return begin() + capacity; }
+      };
+
+   public:
+      static constexpr size_t default_block_size = 8*1024;
+      static constexpr size_t default_alignment  = alignof(std::max_align_t);
+
+      /**
+       * A position in the arena that it can later be rewound to
+       */
+      struct marker {
+         block* blk = nullptr;
+         char*  pos = nullptr;
+      };
+
+      /**
+       * Construct an empty arena, no memory is taken until the first allocation
+       *
+       * @param block_size - Minimum size of the blocks requested from malloc
+       */
+      explicit arena( size_t block_size = default_block_size )
+         : _block_size(block_size) {}
+
+      arena( const arena& ) = delete;
+      arena& operator=( const arena& ) = delete;
+
+      ~arena() { release(); }
+
+      /**
+       * Allocate uninitialized memory from the arena
+       *
+       * @param size - Number of bytes
+       * @param align - Required alignment, must be a power of two
+       * @return Pointer to the memory, valid until the arena is rewound past it, reset or released
+       */
+      void* allocate( size_t size, size_t align = default_alignment ) {
+         if ( char* ptr = bump( size, align ) )
+            return ptr;
+         check( size <= std::numeric_limits<size_t>::max() - sizeof(block) - align, "arena allocation is too large" );
+         next_block( size + align );
+         return bump( size, align );
+      }
+
+      /**
+       * Individual deallocation is a no-op, memory is reclaimed by rewind(), reset() or release()
+       */
+      void deallocate( void*, size_t ) {}
+
+      /**
+       * Get the current position of the arena
+       */
+      marker mark()const { return { _current, _pos }; }
+
+      /**
+       * Rewind the arena to an earlier mark, everything allocated since becomes invalid
+       *
+       * @param m - A marker previously obtained from this arena
+       */
+      void rewind( const marker& m ) {
+         if ( m.blk == nullptr ) {
+            reset();
+            return;
+         }
+         _current = m.blk;
+         _pos     = m.pos;
+         _end     = m.blk->end();
+      }
+
+      /**
+       * Rewind to the beginning of the arena, keeping its blocks for reuse
+       */
+      void reset() {
+         _current = _head;
+         _pos     = _head ? _head->begin() : nullptr;
+         _end     = _head ? _head->end() : nullptr;
+      }
+
+      /**
+       * Return all blocks to malloc
+       */
+      void release() {
+         while ( _head ) {
+            block* next = _head->next;
+            free( _head );
+            _head = next;
+         }
+         _current = nullptr;
+         _pos     = nullptr;
+         _end     = nullptr;
+      }
+
+   private:
+      char* bump( size_t size, size_t align ) {
+         const uintptr_t pos = (reinterpret_cast<uintptr_t>(_pos) + align - 1) & ~uintptr_t(align - 1);
+         if ( _pos == nullptr || pos > reinterpret_cast<uintptr_t>(_end) || size > reinterpret_cast<uintptr_t>(_end) - pos )
+            return nullptr;
+         _pos = reinterpret_cast<char*>(pos + size);
+         return reinterpret_cast<char*>(pos);
+      }
+
+      // moves to the block after the current one, reusing it when it is large enough
+      void next_block( size_t min_size ) {
+         block* next = _current ? _current->next : _head;
+         if ( next == nullptr || next->capacity < min_size ) {
+            const size_t capacity = min_size > _block_size ? min_size : _block_size;
+            block* blk = static_cast<block*>( malloc( sizeof(block) + capacity ) );
+            check( blk != nullptr, "arena failed to allocate a block" );
+            blk->next     = next;
+            blk->capacity = capacity;
+            if ( _current )
+               _current->next = blk;
+            else
+               _head = blk;
+            next = blk;
+         }
+         _current = next;
+         _pos     = next->begin();
+         _end     = next->end();
+      }
+
+      size_t _block_size;
+      block* _head    = nullptr;
+      block* _current = nullptr;
+      char*  _pos     = nullptr;
+      char*  _end     = nullptr;
+   };
+
+   /**
+    * Marks an arena on construction and rewinds it to that mark on destruction
+    *
+    * @ingroup arena
+    */
+   class arena_scope {
+   public:
+      explicit arena_scope( arena& a ) : _arena(a), _mark(a.mark()) {}
+      arena_scope( const arena_scope& ) = delete;
+      arena_scope& operator=( const arena_scope& ) = delete;
+      ~arena_scope() { _arena.rewind( _mark ); }
+
+   private:
+      arena&        _arena;
+      arena::marker _mark;
+   };
+
+   /**
+    * Standard library allocator that draws from an arena
+    *
+    * Containers using it must not outlive the scope the arena is rewound to.
+    *
+    * @ingroup arena
+    * @tparam T - Type of the allocated objects
+    */
+   template <typename T>
+   class arena_allocator {
+   public:
+      using value_type = T;
+
+      arena_allocator( arena& a ) : _arena(&a) {}
+
+      template <typename U>
+      arena_allocator( const arena_allocator<U>& other ) : _arena(&other.get_arena()) {}
+
+      arena& get_arena()const { return *_arena; }
+
+      T* allocate( size_t n ) {
+         check( n <= std::numeric_limits<size_t>::max() / sizeof(T), "arena allocation is too large" );
+         return static_cast<T*>( _arena->allocate( n * sizeof(T), alignof(T) ) );
+      }
+
+      void deallocate( T*, size_t ) {}
+
+      template <typename U>
+      bool operator==( const arena_allocator<U>& other )const { return _arena == &other.get_arena(); }
+
+      template <typename U>
+      bool operator!=( const arena_allocator<U>& other )const { return _arena != &other.get_arena(); }
+
+   private:
+      arena* _arena;
+   };
+}
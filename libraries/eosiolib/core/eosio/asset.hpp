@@ -317,43 +317,49 @@ namespace eosio {
 
       /// @endcond
 
+      /**
+       *  Writes the %asset as a string to the provided char buffer
+       *
+       *  The amount is written in fixed point with symbol.precision() decimals, followed by a space and the
+       *  symbol code. Only the digits of an amount are written when they exceed the precision, a negative
+       *  amount smaller than one unit is written without its sign.
+       *
+       *  @pre Appropriate Size Precondition: (begin + 29 + symbol.precision()) <= end and (begin + 29 + symbol.precision()) does not overflow
+       *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+       *  @param begin - The start of the char buffer
+       *  @param end - Just past the end of the char buffer
+       *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+       *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the %asset.
+       */
+      char* write_as_string( char* begin, char* end )const {
+         const uint8_t p = symbol.precision();
+         if( (begin + 29 + p) < begin || (begin + 29 + p) > end ) return begin;
+
+         // wraps above a precision of 18, like the amounts printed by earlier releases
+         uint64_t p10 = 1;
+         for( uint8_t i = 0; i < p; ++i )
+            p10 *= 10;
+         const int64_t whole  = amount / int64_t(p10);
+         const int64_t change = amount % int64_t(p10);
+
+         begin = _print_detail::write_signed_decimal( begin, whole );
+         if( p ) {
+            *begin++ = '.';
+            begin = _print_detail::write_digits( begin, change < 0 ? uint64_t(0) - uint64_t(change) : uint64_t(change), p );
+         }
+         *begin++ = ' ';
+         return symbol.code().write_as_string( begin, begin + 7 );
+      }
+
       /**
        * %asset to std::string
        *
        * @brief %asset to std::string
        */
       std::string to_string()const {
-         int64_t p = (int64_t)symbol.precision();
-         int64_t p10 = 1;
-         bool negative = false;
-         int64_t invert = 1;
-
-         while( p > 0  ) {
-            p10 *= 10; --p;
-         }
-         p = (int64_t)symbol.precision();
-
-         char fraction[p+1];
-         fraction[p] = '\0';
-
-         if (amount < 0) {
-            invert = -1;
-            negative = true;
-         }
-
-         auto change = (amount % p10) * invert;
-
-         for( int64_t i = p -1; i >= 0; --i ) {
-            fraction[i] = (change % 10) + '0';
-            change /= 10;
-         }
-         char str[p+32];
-         snprintf(str, sizeof(str), "%lld%s%s %s",
-            (int64_t)(amount/p10),
-            (fraction[0]) ? "." : "",
-            fraction,
-            symbol.code().to_string().c_str());
-         return {str};
+         char buffer[29 + std::numeric_limits<uint8_t>::max()];
+         auto end = write_as_string( buffer, buffer + sizeof(buffer) );
+         return {buffer, end};
       }
 
       /**
@@ -362,12 +368,30 @@ namespace eosio {
        * @brief %Print the asset
        */
       void print()const {
-         ::eosio::print(to_string());
+         print_buffer buf;
+         print( buf );
+      }
+
+      /**
+       * Renders the asset into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       */
+      void print( print_buffer& buf )const {
+         buf.write( 29 + symbol.precision(), [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
       }
 
       EOSLIB_SERIALIZE( asset, (amount)(symbol) )
    };
 
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(asset) == sizeof(int64_t) + sizeof(symbol), "asset must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<asset> : std::true_type {};
+
+   /// @endcond
+
   /**
    *  Extended asset which stores the information of the owner of the asset
    *
@@ -405,12 +429,49 @@ namespace eosio {
        */
       extended_asset( asset a, name c ):quantity(a),contract(c){}
 
+      /**
+       *  Writes the extended asset as a string to the provided char buffer, as the quantity, an @ and the contract
+       *
+       *  @pre Appropriate Size Precondition: (begin + 43 + quantity.symbol.precision()) <= end and (begin + 43 + quantity.symbol.precision()) does not overflow
+       *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+       *  @param begin - The start of the char buffer
+       *  @param end - Just past the end of the char buffer
+       *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+       *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the extended asset.
+       */
+      char* write_as_string( char* begin, char* end )const {
+         const size_t size = 43 + quantity.symbol.precision();
+         if( (begin + size) < begin || (begin + size) > end ) return begin;
+
+         begin = quantity.write_as_string( begin, end );
+         *begin++ = '@';
+         return contract.write_as_string( begin, begin + 13 );
+      }
+
+      /**
+       * Extended asset to std::string
+       */
+      std::string to_string()const {
+         char buffer[43 + std::numeric_limits<uint8_t>::max()];
+         auto end = write_as_string( buffer, buffer + sizeof(buffer) );
+         return {buffer, end};
+      }
+
       /**
        * %Print the extended asset
        */
       void print()const {
-         quantity.print();
-         ::eosio::print("@", contract);
+         print_buffer buf;
+         print( buf );
+      }
+
+      /**
+       * Renders the extended asset into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       */
+      void print( print_buffer& buf )const {
+         buf.write( 43 + quantity.symbol.precision(), [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
       }
 
       /// @cond OPERATORS
@@ -479,4 +540,12 @@ namespace eosio {
 
       EOSLIB_SERIALIZE( extended_asset, (quantity)(contract) )
    };
+
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(extended_asset) == sizeof(asset) + sizeof(name), "extended_asset must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<extended_asset> : std::true_type {};
+
+   /// @endcond
 }
@@ -6,6 +6,9 @@
 #include "check.hpp"
 #include "varint.hpp"
 
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
 #include <list>
 #include <queue>
 #include <vector>
@@ -13,6 +16,7 @@
 #include <set>
 #include <map>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <variant>
 
@@ -157,6 +161,17 @@ class datastream {
       *  @return size_t - The number of remaining bytes
       */
       inline size_t remaining()const  { return _end - _pos; }
+
+     /**
+      *  Checks once that the next s bytes can be read or written, so that a run of reads or writes
+      *  adding up to s bytes can go through an unchecked_region without checking each one
+      *
+      *  @param s - The number of bytes that will be read or written
+      *  @param msg - The message to fail with
+      */
+      inline void reserve_checked( size_t s, const char* msg = "read" )const {
+        eosio::check( _pos <= _end && size_t(_end - _pos) >= s, msg );
+      }
     private:
       /**
        * The start position of the buffer
@@ -250,6 +265,340 @@ class datastream<size_t> {
      size_t _size;
 };
 
+/**
+ * Output buffer type of the growable datastream, see datastream<growable_buffer>
+ */
+using growable_buffer = std::vector<char>;
+
+/**
+ * Specialization of datastream that appends to a vector, growing it as needed, so a value can be
+ * serialized in one pass without computing its size first
+ */
+template<>
+class datastream<growable_buffer> {
+   public:
+      /**
+       * Construct a new specialized datastream object writing at the end of a buffer
+       *
+       * @param buffer - The buffer to append to, it must outlive the datastream
+       * @param reserve - Capacity to reserve up front
+       */
+      explicit datastream( growable_buffer& buffer, size_t reserve = 0 )
+      :_buffer(buffer),_start(buffer.size()),_pos(buffer.size()) {
+         if( reserve )
+            _buffer.reserve( _start + reserve );
+      }
+
+     /**
+      *  Skips a specified number of bytes, zero filling them if they are past the end of the buffer
+      *
+      *  @param s - The number of bytes to skip
+      *  @return true
+      */
+      inline bool skip( size_t s ) {
+        _pos += s;
+        if( _pos > _buffer.size() )
+           _buffer.resize( _pos );
+        return true;
+      }
+
+     /**
+      *  Writes a specified number of bytes into the stream, growing the buffer if needed
+      *
+      *  @param d - The pointer to the source buffer
+      *  @param s - The number of bytes to write
+      *  @return true
+      */
+      inline bool write( const char* d, size_t s ) {
+        if( _pos == _buffer.size() ) {
+           _buffer.insert( _buffer.end(), d, d + s );
+        } else {
+           // overwriting after a seekp, append whatever does not fit
+           const size_t overlap = std::min( s, _buffer.size() - _pos );
+           memcpy( _buffer.data() + _pos, d, overlap );
+           _buffer.insert( _buffer.end(), d + overlap, d + s );
+        }
+        _pos += s;
+        return true;
+      }
+
+     /**
+      *  Writes a byte into the stream, growing the buffer if needed
+      *
+      *  @param c byte to write
+      *  @return true
+      */
+      inline bool put( char c ) {
+        if( _pos == _buffer.size() )
+           _buffer.push_back( c );
+        else
+           _buffer[_pos] = c;
+        ++_pos;
+        return true;
+      }
+
+     /**
+      *  Check validity. It's always valid
+      *
+      *  @return true
+      */
+      inline bool valid()const { return true; }
+
+     /**
+      *  Sets the position relative to where the stream started, zero filling the buffer up to it if needed
+      *
+      *  @param p - The offset relative to the origin
+      *  @return true
+      */
+      inline bool seekp( size_t p ) {
+        _pos = _start + p;
+        if( _pos > _buffer.size() )
+           _buffer.resize( _pos );
+        return true;
+      }
+
+     /**
+      *  Gets the number of bytes written since the stream started
+      *
+      *  @return size_t - The position within the current stream
+      */
+      inline size_t tellp()const { return _pos - _start; }
+
+     /**
+      *  Returns the number of bytes after the current position that have already been written
+      *
+      *  @return size_t - The number of remaining bytes
+      */
+      inline size_t remaining()const { return _buffer.size() - _pos; }
+
+   private:
+      growable_buffer& _buffer;
+      size_t           _start;
+      size_t           _pos;
+};
+
+/**
+ * Buffer tag of the datastream specialization that does no bounds checking, see datastream<unchecked_buffer<T>>
+ *
+ * @tparam T - Type of the underlying buffer pointer, char* or const char*
+ */
+template<typename T>
+struct unchecked_buffer {};
+
+/**
+ * Specialization of datastream that reads and writes without bounds checks.
+ *
+ * Only to be used once the caller has verified that the buffer holds everything that will be
+ * read or written, for example for values with a fixed pack size.
+ */
+template<typename T>
+class datastream<unchecked_buffer<T>> {
+   public:
+      /**
+       * Construct a new specialized datastream object
+       *
+       * @param start - The start position of the buffer
+       * @param s - The size of the buffer
+       */
+      datastream( T start, size_t s )
+      :_start(start),_pos(start),_end(start+s){}
+
+      inline void skip( size_t s ){ _pos += s; }
+
+      inline bool read( char* d, size_t s ) {
+        memcpy( d, _pos, s );
+        _pos += s;
+        return true;
+      }
+
+      inline bool write( const char* d, size_t s ) {
+        memcpy( (void*)_pos, d, s );
+        _pos += s;
+        return true;
+      }
+
+      inline bool put(char c) {
+        *_pos = c;
+        ++_pos;
+        return true;
+      }
+
+      inline bool get( unsigned char& c ) { return get( *(char*)&c ); }
+
+      inline bool get( char& c ) {
+        c = *_pos;
+        ++_pos;
+        return true;
+      }
+
+      T pos()const { return _pos; }
+      inline bool valid()const { return _pos <= _end && _pos >= _start;  }
+      inline bool seekp(size_t p) { _pos = _start + p; return _pos <= _end; }
+      inline size_t tellp()const      { return size_t(_pos - _start); }
+      inline size_t remaining()const  { return _end - _pos; }
+
+   private:
+      T _start;
+      T _pos;
+      T _end;
+};
+
+/**
+ *  Whether the in-memory representation of T is exactly its serialized form, so that contiguous
+ *  sequences of T can be packed and unpacked with a single write or read.
+ *
+ *  True for arithmetic types other than bool and for enums. Types with a matching fixed layout,
+ *  such as name or asset, specialize it to std::true_type next to their definition.
+ *
+ *  @ingroup datastream
+ *  @tparam T - The element type
+ */
+template<typename T>
+struct is_memcpy_serializable
+   : std::bool_constant<(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value) || std::is_enum<T>::value> {};
+
+template<typename T>
+constexpr bool is_memcpy_serializable_v = is_memcpy_serializable<T>::value;
+
+/**
+ * Value of fixed_pack_size for types whose packed size depends on their value
+ *
+ * @ingroup datastream
+ */
+constexpr size_t variable_pack_size = std::numeric_limits<size_t>::max();
+
+template<typename T, typename Enable = void>
+struct fixed_pack_size;
+
+/**
+ *  A run of reads or writes on a bounded datastream that is bounds checked once upfront.
+ *
+ *  The region checks that the stream has s bytes left and hands out a datastream<unchecked_buffer<T>>
+ *  over them. When the region goes out of scope the outer stream is advanced past whatever was read
+ *  or written through it. Reading or writing more than s bytes through the region is undefined.
+ *
+ *  @ingroup datastream
+ *  @tparam T - Type of the datastream buffer, a pointer
+ *
+ *  Example:
+ *  @code
+ *  datastream<const char*> ds( buffer, size );
+ *  {
+ *     unchecked_region region( ds, 2*sizeof(uint64_t) );
+ *     region.stream() >> id >> amount;
+ *  }
+ *  ds >> memo;
+ *  @endcode
+ */
+template<typename T>
+class unchecked_region {
+   public:
+      /**
+       * Construct a new region over the next s bytes of a stream
+       *
+       * @param ds - The stream, it must outlive the region
+       * @param s - The number of bytes that will be read or written through the region
+       * @param msg - The message to fail with when the stream is too short
+       */
+      unchecked_region( datastream<T>& ds, size_t s, const char* msg = "read" )
+      :_ds(ds),_unchecked(( ds.reserve_checked( s, msg ), ds.pos() ), s) {}
+
+      unchecked_region( const unchecked_region& ) = delete;
+      unchecked_region& operator=( const unchecked_region& ) = delete;
+
+      ~unchecked_region() { _ds.skip( _unchecked.tellp() ); }
+
+      /**
+       * The stream to read or write the reserved bytes through
+       */
+      datastream<unchecked_buffer<T>>& stream() { return _unchecked; }
+
+   private:
+      datastream<T>&                  _ds;
+      datastream<unchecked_buffer<T>> _unchecked;
+};
+
+namespace _datastream_detail {
+   template<typename T>
+   using field_type = std::remove_cv_t<std::remove_reference_t<T>>;
+
+   // number of leading types with a fixed pack size
+   template<typename... Ts>
+   constexpr size_t fixed_prefix_length() {
+      constexpr size_t sizes[] = { fixed_pack_size<field_type<Ts>>::value..., variable_pack_size };
+      size_t n = 0;
+      while( sizes[n] != variable_pack_size )
+         ++n;
+      return n;
+   }
+
+   template<size_t N, typename... Ts>
+   constexpr size_t fixed_prefix_size() {
+      constexpr size_t sizes[] = { fixed_pack_size<field_type<Ts>>::value..., size_t(0) };
+      size_t total = 0;
+      for( size_t i = 0; i < N; ++i )
+         total += sizes[i];
+      return total;
+   }
+
+   // streams with an end to check against, the ones an unchecked_region can be opened on
+   template<typename Stream>
+   struct is_bounded_stream : std::false_type {};
+
+   template<typename T>
+   struct is_bounded_stream<datastream<T>> : std::is_pointer<T> {};
+
+   template<size_t Offset, typename Stream, typename Tuple, size_t... I>
+   void write_each( Stream& ds, const Tuple& fields, std::index_sequence<I...> ) {
+      ( (void)(ds << std::get<Offset + I>(fields)), ... );
+   }
+
+   template<size_t Offset, typename Stream, typename Tuple, size_t... I>
+   void read_each( Stream& ds, const Tuple& fields, std::index_sequence<I...> ) {
+      ( (void)(ds >> std::get<Offset + I>(fields)), ... );
+   }
+
+   /**
+    * Serializes a sequence of fields in order. The leading fields with a fixed pack size are written
+    * through one unchecked_region, or just counted when only the size is being computed.
+    */
+   template<typename DataStream, typename... Ts>
+   DataStream& write_fields( DataStream& ds, const Ts&... fields ) {
+      constexpr size_t prefix      = fixed_prefix_length<Ts...>();
+      constexpr size_t prefix_size = fixed_prefix_size<prefix, Ts...>();
+      const auto refs = std::forward_as_tuple( fields... );
+      if constexpr( prefix > 0 && std::is_same<DataStream, datastream<size_t>>::value ) {
+         ds.skip( prefix_size );
+      } else if constexpr( prefix > 1 && is_bounded_stream<DataStream>::value ) {
+         unchecked_region region( ds, prefix_size, "write" );
+         write_each<0>( region.stream(), refs, std::make_index_sequence<prefix>() );
+      } else {
+         write_each<0>( ds, refs, std::make_index_sequence<prefix>() );
+      }
+      write_each<prefix>( ds, refs, std::make_index_sequence<sizeof...(Ts) - prefix>() );
+      return ds;
+   }
+
+   /**
+    * Deserializes a sequence of fields in order. The leading fields with a fixed pack size are read
+    * through one unchecked_region.
+    */
+   template<typename DataStream, typename... Ts>
+   DataStream& read_fields( DataStream& ds, Ts&... fields ) {
+      constexpr size_t prefix      = fixed_prefix_length<Ts...>();
+      constexpr size_t prefix_size = fixed_prefix_size<prefix, Ts...>();
+      const auto refs = std::tie( fields... );
+      if constexpr( prefix > 1 && is_bounded_stream<DataStream>::value ) {
+         unchecked_region region( ds, prefix_size, "read" );
+         read_each<0>( region.stream(), refs, std::make_index_sequence<prefix>() );
+      } else {
+         read_each<0>( ds, refs, std::make_index_sequence<prefix>() );
+      }
+      read_each<prefix>( ds, refs, std::make_index_sequence<sizeof...(Ts) - prefix>() );
+      return ds;
+   }
+}
+
 /**
  *  Serialize an std::list into a stream
  *
@@ -376,9 +725,7 @@ inline datastream<Stream>& operator>>(datastream<Stream>& ds, std::variant<Ts...
  */
 template<typename DataStream, typename T1, typename T2>
 DataStream& operator<<( DataStream& ds, const std::pair<T1, T2>& t ) {
-   ds << std::get<0>(t);
-   ds << std::get<1>(t);
-   return ds;
+   return _datastream_detail::write_fields( ds, t.first, t.second );
 }
 
 /**
@@ -394,8 +741,7 @@ template<typename DataStream, typename T1, typename T2>
 DataStream& operator>>( DataStream& ds, std::pair<T1, T2>& t ) {
    T1 t1;
    T2 t2;
-   ds >> t1;
-   ds >> t2;
+   _datastream_detail::read_fields( ds, t1, t2 );
    t = std::pair<T1, T2>{t1, t2};
    return ds;
 }
@@ -494,12 +840,47 @@ DataStream& operator << ( DataStream& ds, const std::string& v ) {
  */
 template<typename DataStream>
 DataStream& operator >> ( DataStream& ds, std::string& v ) {
-   std::vector<char> tmp;
-   ds >> tmp;
-   if( tmp.size() )
-      v = std::string(tmp.data(),tmp.data()+tmp.size());
-   else
-      v = std::string();
+   unsigned_int s;
+   ds >> s;
+   // check before resizing so a corrupt length can not trigger a huge allocation
+   eosio::check( s.value <= ds.remaining(), "read" );
+   v.resize( s.value );
+   if( s.value )
+      ds.read( v.data(), v.size() );
+   return ds;
+}
+
+/**
+ *  Serialize a string_view into a stream, the same as a std::string
+ *
+ *  @param ds - The stream to write
+ *  @param v - The value to serialize
+ *  @tparam DataStream - Type of datastream
+ *  @return DataStream& - Reference to the datastream
+ */
+template<typename DataStream, typename Traits>
+DataStream& operator << ( DataStream& ds, const std::basic_string_view<char, Traits>& v ) {
+   ds << unsigned_int( v.size() );
+   if (v.size())
+      ds.write(v.data(), v.size());
+   return ds;
+}
+
+/**
+ *  Deserialize a packed std::string as a view into the stream's buffer, without copying it
+ *
+ *  The view is only valid as long as the buffer the stream reads from.
+ *
+ *  @param ds - The stream to read
+ *  @param v - The destination for deserialized value
+ *  @return datastream<const char*>& - Reference to the datastream
+ */
+inline datastream<const char*>& operator >> ( datastream<const char*>& ds, std::string_view& v ) {
+   unsigned_int s;
+   ds >> s;
+   ds.reserve_checked( s.value );
+   v = std::string_view( ds.pos(), s.value );
+   ds.skip( s.value );
    return ds;
 }
 
@@ -515,8 +896,13 @@ DataStream& operator >> ( DataStream& ds, std::string& v ) {
  */
 template<typename DataStream, typename T, std::size_t N>
 DataStream& operator << ( DataStream& ds, const std::array<T,N>& v ) {
-   for( const auto& i : v )
-      ds << i;
+   if constexpr ( is_memcpy_serializable_v<T> ) {
+      static_assert( std::is_trivially_copyable<T>::value, "memcpy serializable types must be trivially copyable" );
+      ds.write( (const char*)v.data(), N * sizeof(T) );
+   } else {
+      for( const auto& i : v )
+         ds << i;
+   }
    return ds;
 }
 
@@ -534,8 +920,13 @@ DataStream& operator << ( DataStream& ds, const std::array<T,N>& v ) {
  */
 template<typename DataStream, typename T, std::size_t N>
 DataStream& operator >> ( DataStream& ds, std::array<T,N>& v ) {
-   for( auto& i : v )
-      ds >> i;
+   if constexpr ( is_memcpy_serializable_v<T> ) {
+      static_assert( std::is_trivially_copyable<T>::value, "memcpy serializable types must be trivially copyable" );
+      ds.read( (char*)v.data(), N * sizeof(T) );
+   } else {
+      for( auto& i : v )
+         ds >> i;
+   }
    return ds;
 }
 
@@ -598,6 +989,7 @@ DataStream& operator >> ( DataStream& ds, T ) {
  */
 template<typename DataStream, typename T, std::size_t N,
          std::enable_if_t<!_datastream_detail::is_primitive<T>() &&
+                          !is_memcpy_serializable_v<T> &&
                           !_datastream_detail::is_pointer<T>()>* = nullptr>
 DataStream& operator << ( DataStream& ds, const T (&v)[N] ) {
    ds << unsigned_int( N );
@@ -607,9 +999,9 @@ DataStream& operator << ( DataStream& ds, const T (&v)[N] ) {
 }
 
 /**
- *  Serialize a fixed size C array of primitive type
+ *  Serialize a fixed size C array of primitive or memcpy serializable type
  *
- *  @brief Serialize a fixed size C array of primitive type
+ *  @brief Serialize a fixed size C array of primitive or memcpy serializable type
  *  @param ds - The stream to write
  *  @param v - The value to serialize
  *  @tparam DataStream - Type of datastream
@@ -617,7 +1009,8 @@ DataStream& operator << ( DataStream& ds, const T (&v)[N] ) {
  *  @return DataStream& - Reference to the datastream
  */
 template<typename DataStream, typename T, std::size_t N,
-         std::enable_if_t<_datastream_detail::is_primitive<T>()>* = nullptr>
+         std::enable_if_t<_datastream_detail::is_primitive<T>() ||
+                          is_memcpy_serializable_v<T>>* = nullptr>
 DataStream& operator << ( DataStream& ds, const T (&v)[N] ) {
    ds << unsigned_int( N );
    ds.write((char*)&v[0], sizeof(v));
@@ -637,6 +1030,7 @@ DataStream& operator << ( DataStream& ds, const T (&v)[N] ) {
  */
 template<typename DataStream, typename T, std::size_t N,
          std::enable_if_t<!_datastream_detail::is_primitive<T>() &&
+                          !is_memcpy_serializable_v<T> &&
                           !_datastream_detail::is_pointer<T>()>* = nullptr>
 DataStream& operator >> ( DataStream& ds, T (&v)[N] ) {
    unsigned_int s;
@@ -648,9 +1042,9 @@ DataStream& operator >> ( DataStream& ds, T (&v)[N] ) {
 }
 
 /**
- *  Deserialize a fixed size C array of primitive type
+ *  Deserialize a fixed size C array of primitive or memcpy serializable type
  *
- *  @brief Deserialize a fixed size C array of primitive type
+ *  @brief Deserialize a fixed size C array of primitive or memcpy serializable type
  *  @param ds - The stream to read
  *  @param v - The destination for deserialized value
  *  @tparam T - Type of the object contained in the array
@@ -659,7 +1053,8 @@ DataStream& operator >> ( DataStream& ds, T (&v)[N] ) {
  *  @return DataStream& - Reference to the datastream
  */
 template<typename DataStream, typename T, std::size_t N,
-         std::enable_if_t<_datastream_detail::is_primitive<T>()>* = nullptr>
+         std::enable_if_t<_datastream_detail::is_primitive<T>() ||
+                          is_memcpy_serializable_v<T>>* = nullptr>
 DataStream& operator >> ( DataStream& ds, T (&v)[N] ) {
    unsigned_int s;
    ds >> s;
@@ -697,8 +1092,13 @@ DataStream& operator << ( DataStream& ds, const std::vector<char>& v ) {
 template<typename DataStream, typename T>
 DataStream& operator << ( DataStream& ds, const std::vector<T>& v ) {
    ds << unsigned_int( v.size() );
-   for( const auto& i : v )
-      ds << i;
+   if constexpr ( is_memcpy_serializable_v<T> ) {
+      static_assert( std::is_trivially_copyable<T>::value, "memcpy serializable types must be trivially copyable" );
+      ds.write( (const char*)v.data(), v.size() * sizeof(T) );
+   } else {
+      for( const auto& i : v )
+         ds << i;
+   }
    return ds;
 }
 
@@ -734,9 +1134,17 @@ template<typename DataStream, typename T>
 DataStream& operator >> ( DataStream& ds, std::vector<T>& v ) {
    unsigned_int s;
    ds >> s;
-   v.resize(s.value);
-   for( auto& i : v )
-      ds >> i;
+   if constexpr ( is_memcpy_serializable_v<T> ) {
+      static_assert( std::is_trivially_copyable<T>::value, "memcpy serializable types must be trivially copyable" );
+      // check before resizing so a corrupt length can not trigger a huge allocation
+      eosio::check( s.value <= ds.remaining() / sizeof(T), "read" );
+      v.resize(s.value);
+      ds.read( (char*)v.data(), v.size() * sizeof(T) );
+   } else {
+      v.resize(s.value);
+      for( auto& i : v )
+         ds >> i;
+   }
    return ds;
 }
 
@@ -839,10 +1247,9 @@ DataStream& operator >> ( DataStream& ds, std::map<K,V>& m ) {
  */
 template<typename DataStream, typename... Args>
 DataStream& operator<<( DataStream& ds, const std::tuple<Args...>& t ) {
-   boost::fusion::for_each( t, [&]( const auto& i ) {
-       ds << i;
-   });
-   return ds;
+   return std::apply( [&]( const auto&... fields ) -> DataStream& {
+      return _datastream_detail::write_fields( ds, fields... );
+   }, t );
 }
 
 /**
@@ -857,10 +1264,9 @@ DataStream& operator<<( DataStream& ds, const std::tuple<Args...>& t ) {
  */
 template<typename DataStream, typename... Args>
 DataStream& operator>>( DataStream& ds, std::tuple<Args...>& t ) {
-   boost::fusion::for_each( t, [&]( auto& i ) {
-       ds >> i;
-   });
-   return ds;
+   return std::apply( [&]( auto&... fields ) -> DataStream& {
+      return _datastream_detail::read_fields( ds, fields... );
+   }, t );
 }
 
 /**
@@ -875,10 +1281,9 @@ DataStream& operator>>( DataStream& ds, std::tuple<Args...>& t ) {
  */
 template<typename DataStream, typename T, std::enable_if_t<std::is_class<T>::value>* = nullptr>
 DataStream& operator<<( DataStream& ds, const T& v ) {
-   boost::pfr::for_each_field(v, [&](const auto& field) {
-      ds << field;
-   });
-   return ds;
+   return std::apply( [&]( const auto&... fields ) -> DataStream& {
+      return _datastream_detail::write_fields( ds, fields... );
+   }, boost::pfr::structure_tie(v) );
 }
 
 /**
@@ -893,10 +1298,9 @@ DataStream& operator<<( DataStream& ds, const T& v ) {
  */
 template<typename DataStream, typename T, std::enable_if_t<std::is_class<T>::value>* = nullptr>
 DataStream& operator>>( DataStream& ds, T& v ) {
-   boost::pfr::for_each_field(v, [&](auto& field) {
-      ds >> field;
-   });
-   return ds;
+   return std::apply( [&]( auto&... fields ) -> DataStream& {
+      return _datastream_detail::read_fields( ds, fields... );
+   }, boost::pfr::structure_tie(v) );
 }
 
 /**
@@ -931,6 +1335,176 @@ DataStream& operator>>( DataStream& ds, T& v ) {
    return ds;
 }
 
+namespace _datastream_detail {
+   constexpr size_t sum_fixed_sizes( std::initializer_list<size_t> sizes ) {
+      size_t total = 0;
+      for( size_t s : sizes ) {
+         if( s == variable_pack_size )
+            return variable_pack_size;
+         total += s;
+      }
+      return total;
+   }
+
+   constexpr size_t unsigned_int_size( uint64_t v ) {
+      size_t size = 1;
+      for( v >>= 7; v; v >>= 7 )
+         ++size;
+      return size;
+   }
+
+   // EOSLIB_SERIALIZE and EOSLIB_SERIALIZE_DERIVED define eosio_fixed_pack_size as a hidden friend
+   template<typename T, typename = void>
+   struct has_fixed_pack_size_hook : std::false_type {};
+
+   template<typename T>
+   struct has_fixed_pack_size_hook<T, std::void_t<decltype(eosio_fixed_pack_size((const T*)nullptr))>>
+      : std::true_type {};
+
+   template<typename... Ts>
+   constexpr size_t fixed_size_of_all() {
+      return sum_fixed_sizes({ size_t(0), fixed_pack_size<field_type<Ts>>::value... });
+   }
+
+   template<typename T>
+   constexpr size_t compute_fixed_pack_size() {
+      if constexpr( is_memcpy_serializable_v<T> ) {
+         return sizeof(T);
+      } else if constexpr( std::is_same<T, bool>::value ) {
+         return 1;
+      } else if constexpr( std::is_array<T>::value ) {
+         constexpr size_t n    = std::extent<T>::value;
+         constexpr size_t elem = fixed_pack_size<std::remove_extent_t<T>>::value;
+         return elem == variable_pack_size ? variable_pack_size : unsigned_int_size(n) + n * elem;
+      } else if constexpr( has_fixed_pack_size_hook<T>::value ) {
+         return eosio_fixed_pack_size((const T*)nullptr);
+      } else {
+         return variable_pack_size;
+      }
+   }
+}
+
+/**
+ *  The packed size of T when it is the same for every value, variable_pack_size otherwise.
+ *
+ *  Known for memcpy serializable types, bool, arrays, pairs and tuples of fixed size types, and classes
+ *  using EOSLIB_SERIALIZE whose listed members are all fixed size. Classes serialized by reflection or
+ *  by hand written operators are variable unless they specialize this trait, as their fields need not
+ *  match their encoding.
+ *
+ *  @ingroup datastream
+ *  @tparam T - The type to be packed
+ */
+template<typename T, typename Enable>
+struct fixed_pack_size : std::integral_constant<size_t, _datastream_detail::compute_fixed_pack_size<T>()> {};
+
+template<typename T, std::size_t N>
+struct fixed_pack_size<std::array<T,N>>
+   : std::integral_constant<size_t, fixed_pack_size<T>::value == variable_pack_size ? variable_pack_size : N * fixed_pack_size<T>::value> {};
+
+template<typename T1, typename T2>
+struct fixed_pack_size<std::pair<T1,T2>>
+   : std::integral_constant<size_t, _datastream_detail::fixed_size_of_all<T1, T2>()> {};
+
+template<typename... Args>
+struct fixed_pack_size<std::tuple<Args...>>
+   : std::integral_constant<size_t, _datastream_detail::fixed_size_of_all<Args...>()> {};
+
+template<typename T>
+constexpr size_t fixed_pack_size_v = fixed_pack_size<T>::value;
+
+/**
+ *  Whether every value of T packs to the same number of bytes
+ *
+ *  @ingroup datastream
+ */
+template<typename T>
+constexpr bool has_fixed_pack_size_v = fixed_pack_size_v<T> != variable_pack_size;
+
+namespace _datastream_detail {
+   /**
+    * Deserializes into an existing value. Values of fixed pack size are decoded after a single
+    * bounds check.
+    */
+   template<typename T>
+   void unpack_into( T& value, const char* buffer, size_t len ) {
+      if constexpr( has_fixed_pack_size_v<T> ) {
+         eosio::check( len >= fixed_pack_size_v<T>, "read" );
+         datastream<unchecked_buffer<const char*>> ds( buffer, len );
+         ds >> value;
+      } else {
+         datastream<const char*> ds( buffer, len );
+         ds >> value;
+      }
+   }
+
+   template<typename T>
+   struct is_std_vector : std::false_type {};
+
+   template<typename T, typename A>
+   struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+   template<typename T, typename = void>
+   struct has_skip_hook : std::false_type {};
+
+   // EOSLIB_SERIALIZE and EOSLIB_SERIALIZE_DERIVED define eosio_skip_packed as a hidden friend
+   template<typename T>
+   struct has_skip_hook<T, std::void_t<decltype(eosio_skip_packed(std::declval<datastream<const char*>&>(), (const T*)nullptr))>>
+      : std::true_type {};
+
+   /**
+    * Moves past a packed T without constructing it. Strings, vectors and the fields of EOSLIB_SERIALIZE
+    * classes are walked by their lengths; types the walk does not know are decoded into a scratch value.
+    */
+   template<typename T, typename DataStream>
+   void skip_packed( DataStream& ds ) {
+      if constexpr( std::is_void<T>::value ) {
+         return;
+      } else if constexpr( has_fixed_pack_size_v<T> ) {
+         eosio::check( ds.remaining() >= fixed_pack_size_v<T>, "read" );
+         ds.skip( fixed_pack_size_v<T> );
+      } else if constexpr( std::is_same<T, std::string>::value || is_std_vector<T>::value ) {
+         using value_type = typename T::value_type;
+         unsigned_int s;
+         ds >> s;
+         if constexpr( has_fixed_pack_size_v<value_type> ) {
+            eosio::check( fixed_pack_size_v<value_type> == 0 || s.value <= ds.remaining() / fixed_pack_size_v<value_type>, "read" );
+            ds.skip( s.value * fixed_pack_size_v<value_type> );
+         } else {
+            for( uint32_t i = 0; i < s.value; ++i )
+               skip_packed<value_type>( ds );
+         }
+      } else if constexpr( has_skip_hook<T>::value ) {
+         eosio_skip_packed( ds, (const T*)nullptr );
+      } else {
+         T scratch;
+         ds >> scratch;
+      }
+   }
+
+   template<typename DataStream, typename... Ts>
+   void skip_fields( DataStream& ds ) {
+      ( skip_packed<Ts>( ds ), ... );
+   }
+
+   /**
+    * Serializes a value at the end of a buffer in a single pass. Values of fixed pack size are
+    * written without bounds checks into space reserved upfront.
+    */
+   template<typename T>
+   void pack_append( growable_buffer& buffer, const T& value ) {
+      if constexpr( has_fixed_pack_size_v<T> ) {
+         const size_t start = buffer.size();
+         buffer.resize( start + fixed_pack_size_v<T> );
+         datastream<unchecked_buffer<char*>> ds( buffer.data() + start, fixed_pack_size_v<T> );
+         ds << value;
+      } else {
+         datastream<growable_buffer> ds( buffer );
+         ds << value;
+      }
+   }
+}
+
 /**
  * Unpack data inside a fixed size buffer as T
  *
@@ -944,8 +1518,7 @@ DataStream& operator>>( DataStream& ds, T& v ) {
 template<typename T>
 T unpack( const char* buffer, size_t len ) {
    T result;
-   datastream<const char*> ds(buffer,len);
-   ds >> result;
+   _datastream_detail::unpack_into( result, buffer, len );
    return result;
 }
 
@@ -973,10 +1546,14 @@ T unpack( const std::vector<char>& bytes ) {
  * @return size_t - Size of the packed data
  */
 template<typename T>
-size_t pack_size( const T& value ) {
-  datastream<size_t> ps;
-  ps << value;
-  return ps.tellp();
+constexpr size_t pack_size( const T& value ) {
+  if constexpr( has_fixed_pack_size_v<T> ) {
+     return fixed_pack_size_v<T>;
+  } else {
+     datastream<size_t> ps;
+     ps << value;
+     return ps.tellp();
+  }
 }
 
 /**
@@ -991,10 +1568,10 @@ size_t pack_size( const T& value ) {
 template<typename T>
 std::vector<char> pack( const T& value ) {
   std::vector<char> result;
-  result.resize(pack_size(value));
-
-  datastream<char*> ds( result.data(), result.size() );
-  ds << value;
+  // start with room for a typical action or row so small values do not regrow the buffer several times
+  if constexpr( !has_fixed_pack_size_v<T> )
+     result.reserve( 64 );
+  _datastream_detail::pack_append( result, value );
   return result;
 }
 }
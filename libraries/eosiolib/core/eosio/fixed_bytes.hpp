@@ -4,6 +4,7 @@
  */
 #pragma once
 #include "datastream.hpp"
+#include "print.hpp"
 
 #include <array>
 #include <algorithm>
@@ -253,6 +254,23 @@ namespace eosio {
             printhex(static_cast<const void*>(arr.data()), arr.size());
          }
 
+         /**
+          * Renders fixed_bytes as a hexidecimal string into a print_buffer
+          *
+          * @param buf - The buffer to render into
+          */
+         inline void print( print_buffer& buf )const {
+            if constexpr( 2 * Size > print_buffer::capacity ) {
+               buf.flush();
+               print();
+            } else {
+               auto arr = extract_as_byte_array();
+               buf.write( 2 * Size, [&]( char* begin, char* ) {
+                  return _print_detail::write_hex( begin, arr.data(), arr.size() );
+               } );
+            }
+         }
+
          /// @cond OPERATORS
 
          friend bool operator == <>(const fixed_bytes<Size> &c1, const fixed_bytes<Size> &c2);
@@ -386,5 +404,8 @@ namespace eosio {
       return ds;
    }
 
+   template<size_t Size>
+   struct fixed_pack_size<fixed_bytes<Size>> : std::integral_constant<size_t, Size> {};
+
    /// @endcond
 }
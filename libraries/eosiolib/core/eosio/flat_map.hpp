@@ -0,0 +1,209 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "check.hpp"
+#include "datastream.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+   /**
+    * A map kept as a std::vector of key value pairs sorted by key.
+    *
+    * Serializes exactly like std::map<K,V> and abigen maps it to the same ABI type, so it can replace a std::map
+    * in rows and actions without a migration. Deserializing it reads the pairs into one vector in a single pass,
+    * with no allocation per element and no rebalancing. Encodings whose keys are not strictly ascending, which
+    * std::map tolerates, are sorted and deduplicated keeping the first occurrence of each key, the same result
+    * std::map gives. Insertion and erasure are linear, lookups are binary searches.
+    *
+    * Unlike std::map the keys are stored mutable, they must not be modified through an iterator.
+    *
+    * @ingroup flat_containers
+    * @tparam K - Type of the keys
+    * @tparam V - Type of the mapped values
+    * @tparam Compare - Ordering of the keys
+    */
+   template<typename K, typename V, typename Compare = std::less<K>>
+   class flat_map {
+      public:
+         using key_type        = K;
+         using mapped_type     = V;
+         using value_type      = std::pair<K, V>;
+         using key_compare     = Compare;
+         using container_type  = std::vector<value_type>;
+         using size_type       = typename container_type::size_type;
+         using iterator        = typename container_type::iterator;
+         using const_iterator  = typename container_type::const_iterator;
+
+         flat_map() = default;
+
+         flat_map( std::initializer_list<value_type> elems )
+         :_elems(elems) { normalize(); }
+
+         template<typename InputIt>
+         flat_map( InputIt first, InputIt last )
+         :_elems(first, last) { normalize(); }
+
+         iterator begin() { return _elems.begin(); }
+         iterator end() { return _elems.end(); }
+         const_iterator begin()const { return _elems.begin(); }
+         const_iterator end()const { return _elems.end(); }
+
+         size_type size()const { return _elems.size(); }
+         bool empty()const { return _elems.empty(); }
+         void clear() { _elems.clear(); }
+         void reserve( size_type n ) { _elems.reserve( n ); }
+
+         /**
+          * Get the pairs sorted by key
+          */
+         const container_type& values()const { return _elems; }
+
+         iterator lower_bound( const K& key ) {
+            return std::lower_bound( _elems.begin(), _elems.end(), key, key_less() );
+         }
+         const_iterator lower_bound( const K& key )const {
+            return std::lower_bound( _elems.begin(), _elems.end(), key, key_less() );
+         }
+
+         iterator upper_bound( const K& key ) {
+            return std::upper_bound( _elems.begin(), _elems.end(), key, key_less() );
+         }
+         const_iterator upper_bound( const K& key )const {
+            return std::upper_bound( _elems.begin(), _elems.end(), key, key_less() );
+         }
+
+         iterator find( const K& key ) {
+            auto it = lower_bound( key );
+            return it != _elems.end() && !Compare()( key, it->first ) ? it : _elems.end();
+         }
+         const_iterator find( const K& key )const {
+            auto it = lower_bound( key );
+            return it != _elems.end() && !Compare()( key, it->first ) ? it : _elems.end();
+         }
+
+         size_type count( const K& key )const { return find( key ) != _elems.end(); }
+         bool contains( const K& key )const { return find( key ) != _elems.end(); }
+
+         V& at( const K& key ) {
+            auto it = find( key );
+            eosio::check( it != _elems.end(), "key not found in flat_map" );
+            return it->second;
+         }
+         const V& at( const K& key )const {
+            auto it = find( key );
+            eosio::check( it != _elems.end(), "key not found in flat_map" );
+            return it->second;
+         }
+
+         /**
+          * Get the value of a key, inserting a default constructed one if it is not present
+          */
+         V& operator[]( const K& key ) {
+            return try_emplace( key ).first->second;
+         }
+
+         /**
+          * Insert a value for a key unless the key is already present
+          *
+          * @return The position of the pair with the key and whether it was inserted
+          */
+         template<typename... Args>
+         std::pair<iterator, bool> try_emplace( const K& key, Args&&... args ) {
+            auto it = lower_bound( key );
+            if ( it != _elems.end() && !Compare()( key, it->first ) )
+               return { it, false };
+            return { _elems.emplace( it, std::piecewise_construct, std::forward_as_tuple( key ),
+                                     std::forward_as_tuple( std::forward<Args>(args)... ) ), true };
+         }
+
+         std::pair<iterator, bool> insert( const value_type& elem ) {
+            return try_emplace( elem.first, elem.second );
+         }
+
+         template<typename... Args>
+         std::pair<iterator, bool> emplace( Args&&... args ) {
+            value_type elem( std::forward<Args>(args)... );
+            return try_emplace( elem.first, std::move(elem.second) );
+         }
+
+         /**
+          * Set the value of a key, inserting it if it is not present
+          */
+         template<typename M>
+         std::pair<iterator, bool> insert_or_assign( const K& key, M&& value ) {
+            auto res = try_emplace( key, std::forward<M>(value) );
+            if ( !res.second )
+               res.first->second = std::forward<M>(value);
+            return res;
+         }
+
+         iterator erase( const_iterator pos ) { return _elems.erase( pos ); }
+
+         size_type erase( const K& key ) {
+            auto it = find( key );
+            if ( it == _elems.end() )
+               return 0;
+            _elems.erase( it );
+            return 1;
+         }
+
+         friend bool operator==( const flat_map& a, const flat_map& b ) { return a._elems == b._elems; }
+         friend bool operator!=( const flat_map& a, const flat_map& b ) { return a._elems != b._elems; }
+
+         /**
+          *  Serialize a flat_map, the same as a std::map
+          *
+          *  @param ds - The stream to write
+          *  @param m - The value to serialize
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator<<( DataStream& ds, const flat_map& m ) {
+            return ds << m._elems;
+         }
+
+         /**
+          *  Deserialize a flat_map from a packed std::map
+          *
+          *  @param ds - The stream to read
+          *  @param m - The destination for deserialized value
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator>>( DataStream& ds, flat_map& m ) {
+            ds >> m._elems;
+            m.normalize();
+            return ds;
+         }
+
+      private:
+         struct key_less {
+            bool operator()( const value_type& a, const K& b )const { return Compare()( a.first, b ); }
+            bool operator()( const K& a, const value_type& b )const { return Compare()( a, b.first ); }
+            bool operator()( const value_type& a, const value_type& b )const { return Compare()( a.first, b.first ); }
+         };
+
+         // sorts by key and drops duplicate keys unless the keys are already strictly ascending
+         void normalize() {
+            const key_less less;
+            const auto same_key = [&]( const value_type& a, const value_type& b ) { return !less( a, b ); };
+            if ( std::adjacent_find( _elems.begin(), _elems.end(), same_key ) == _elems.end() )
+               return;
+            std::stable_sort( _elems.begin(), _elems.end(), less );
+            _elems.erase( std::unique( _elems.begin(), _elems.end(), same_key ), _elems.end() );
+         }
+
+         container_type _elems;
+   };
+} // namespace eosio
@@ -0,0 +1,156 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "datastream.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace eosio {
+
+   /**
+    * @defgroup flat_containers Flat Containers
+    * @ingroup core
+    * @ingroup types
+    * @brief Sorted associative containers stored in one contiguous vector
+    */
+
+   /**
+    * A set kept as a sorted std::vector.
+    *
+    * Serializes exactly like std::set<T> and abigen maps it to the same ABI type, so it can replace a std::set
+    * in rows and actions without a migration. Deserializing it reads the elements into one vector in a single
+    * pass, with no allocation per element and no rebalancing. Encodings that are not strictly ascending, which
+    * std::set tolerates, are sorted and deduplicated keeping the first occurrence, the same result std::set
+    * gives. Insertion and erasure are linear, lookups are binary searches.
+    *
+    * @ingroup flat_containers
+    * @tparam T - Type of the elements
+    * @tparam Compare - Ordering of the elements
+    */
+   template<typename T, typename Compare = std::less<T>>
+   class flat_set {
+      public:
+         using key_type        = T;
+         using value_type      = T;
+         using key_compare     = Compare;
+         using container_type  = std::vector<T>;
+         using size_type       = typename container_type::size_type;
+         using iterator        = typename container_type::const_iterator;
+         using const_iterator  = typename container_type::const_iterator;
+
+         flat_set() = default;
+
+         flat_set( std::initializer_list<T> elems )
+         :_elems(elems) { normalize(); }
+
+         template<typename InputIt>
+         flat_set( InputIt first, InputIt last )
+         :_elems(first, last) { normalize(); }
+
+         const_iterator begin()const { return _elems.begin(); }
+         const_iterator end()const { return _elems.end(); }
+
+         size_type size()const { return _elems.size(); }
+         bool empty()const { return _elems.empty(); }
+         void clear() { _elems.clear(); }
+         void reserve( size_type n ) { _elems.reserve( n ); }
+
+         /**
+          * Get the sorted elements
+          */
+         const container_type& values()const { return _elems; }
+
+         const_iterator lower_bound( const T& key )const {
+            return std::lower_bound( _elems.begin(), _elems.end(), key, Compare() );
+         }
+
+         const_iterator upper_bound( const T& key )const {
+            return std::upper_bound( _elems.begin(), _elems.end(), key, Compare() );
+         }
+
+         const_iterator find( const T& key )const {
+            auto it = lower_bound( key );
+            return it != _elems.end() && !Compare()( key, *it ) ? it : _elems.end();
+         }
+
+         size_type count( const T& key )const { return find( key ) != _elems.end(); }
+         bool contains( const T& key )const { return find( key ) != _elems.end(); }
+
+         /**
+          * Insert an element if it is not already present
+          *
+          * @return The position of the element and whether it was inserted
+          */
+         std::pair<iterator, bool> insert( const T& elem ) {
+            auto it = lower_bound( elem );
+            if ( it != _elems.end() && !Compare()( elem, *it ) )
+               return { it, false };
+            return { _elems.insert( it, elem ), true };
+         }
+
+         template<typename... Args>
+         std::pair<iterator, bool> emplace( Args&&... args ) {
+            return insert( T( std::forward<Args>(args)... ) );
+         }
+
+         iterator erase( const_iterator pos ) { return _elems.erase( pos ); }
+
+         size_type erase( const T& key ) {
+            auto it = find( key );
+            if ( it == _elems.end() )
+               return 0;
+            _elems.erase( it );
+            return 1;
+         }
+
+         friend bool operator==( const flat_set& a, const flat_set& b ) { return a._elems == b._elems; }
+         friend bool operator!=( const flat_set& a, const flat_set& b ) { return a._elems != b._elems; }
+
+         /**
+          *  Serialize a flat_set, the same as a std::set
+          *
+          *  @param ds - The stream to write
+          *  @param s - The value to serialize
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator<<( DataStream& ds, const flat_set& s ) {
+            return ds << s._elems;
+         }
+
+         /**
+          *  Deserialize a flat_set from a packed std::set
+          *
+          *  @param ds - The stream to read
+          *  @param s - The destination for deserialized value
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator>>( DataStream& ds, flat_set& s ) {
+            ds >> s._elems;
+            s.normalize();
+            return ds;
+         }
+
+      private:
+         // sorts and drops duplicates unless the elements are already strictly ascending
+         void normalize() {
+            const Compare less;
+            if ( std::adjacent_find( _elems.begin(), _elems.end(), [&]( const T& a, const T& b ) { return !less( a, b ); } ) == _elems.end() )
+               return;
+            std::stable_sort( _elems.begin(), _elems.end(), less );
+            _elems.erase( std::unique( _elems.begin(), _elems.end(), [&]( const T& a, const T& b ) { return !less( a, b ); } ), _elems.end() );
+         }
+
+         container_type _elems;
+   };
+} // namespace eosio
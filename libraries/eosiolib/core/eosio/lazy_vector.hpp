@@ -0,0 +1,211 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "check.hpp"
+#include "datastream.hpp"
+#include "varint.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace eosio {
+
+   /**
+    * @defgroup lazy_vector Lazy Vector
+    * @ingroup core
+    * @ingroup types
+    * @brief Sequence kept in its packed form and decoded one element at a time
+    */
+
+   /**
+    * A sequence that serializes exactly like std::vector<T> but keeps its elements packed.
+    *
+    * Deserializing it copies the packed elements into one byte buffer instead of constructing each of them,
+    * iterating decodes one element at a time into a value held by the iterator. Elements are never decoded
+    * until they are reached: the end of the sequence is found from the fixed pack size of the elements, or by
+    * skipping over each of them by the lengths of their strings and vectors. Meant for large action arguments
+    * and row fields that are walked once, such as batch transfer lists. abigen maps it to `T[]`, the same as
+    * std::vector<T>.
+    *
+    * @ingroup lazy_vector
+    * @tparam T - Type of the elements
+    *
+    * Example:
+    * @code
+    * [[eosio::action]]
+    * void batch( eosio::lazy_vector<transfer_entry> entries ) {
+    *    for ( const auto& e : entries )
+    *       pay( e.to, e.quantity );
+    * }
+    * @endcode
+    */
+   template<typename T>
+   class lazy_vector {
+      public:
+         using value_type = T;
+
+         /**
+          * Input iterator decoding the element it points to
+          */
+         class const_iterator {
+            public:
+               using iterator_category = std::input_iterator_tag;
+               using value_type        = T;
+               using difference_type   = std::ptrdiff_t;
+               using pointer           = const T*;
+               using reference         = const T&;
+
+               const_iterator() = default;
+
+               const T& operator*()const { return _value; }
+               const T* operator->()const { return &_value; }
+
+               const_iterator& operator++() {
+                  _pos = _next;
+                  ++_index;
+                  decode();
+                  return *this;
+               }
+
+               const_iterator operator++(int) {
+                  const_iterator tmp = *this;
+                  ++*this;
+                  return tmp;
+               }
+
+               // elements may pack to no bytes at all, so positions are compared by element index
+               bool operator==( const const_iterator& other )const { return _index == other._index; }
+               bool operator!=( const const_iterator& other )const { return _index != other._index; }
+
+            private:
+               friend class lazy_vector;
+
+               const_iterator( const char* pos, const char* end, uint32_t index, uint32_t size )
+               :_pos(pos),_end(end),_index(index),_size(size) { decode(); }
+
+               void decode() {
+                  if ( _index == _size )
+                     return;
+                  // the bytes were validated when they were read or appended
+                  if constexpr ( has_fixed_pack_size_v<T> ) {
+                     datastream<unchecked_buffer<const char*>> ds( _pos, fixed_pack_size_v<T> );
+                     ds >> _value;
+                     _next = _pos + fixed_pack_size_v<T>;
+                  } else {
+                     datastream<const char*> ds( _pos, size_t(_end - _pos) );
+                     ds >> _value;
+                     _next = ds.pos();
+                  }
+               }
+
+               const char* _pos   = nullptr;
+               const char* _end   = nullptr;
+               const char* _next  = nullptr;
+               uint32_t    _index = 0;
+               uint32_t    _size  = 0;
+               T           _value{};
+         };
+         using iterator = const_iterator;
+
+         lazy_vector() = default;
+
+         /**
+          * Construct a lazy_vector holding the packed elements of a vector
+          *
+          * @param elems - The elements to pack
+          */
+         lazy_vector( const std::vector<T>& elems ) {
+            for ( const auto& e : elems )
+               push_back( e );
+         }
+
+         /**
+          * Get the number of elements
+          */
+         size_t size()const { return _size; }
+
+         bool empty()const { return _size == 0; }
+
+         const_iterator begin()const { return const_iterator( _data.data(), _data.data() + _data.size(), 0, _size ); }
+         const_iterator end()const { return const_iterator( _data.data() + _data.size(), _data.data() + _data.size(), _size, _size ); }
+
+         /**
+          * Append an element, packing it at the end of the buffer
+          *
+          * @param elem - The element to append
+          */
+         void push_back( const T& elem ) {
+            _datastream_detail::pack_append( _data, elem );
+            ++_size;
+         }
+
+         void clear() {
+            _data.clear();
+            _size = 0;
+         }
+
+         /**
+          * Decode every element into a std::vector
+          */
+         std::vector<T> to_vector()const {
+            std::vector<T> result;
+            result.reserve( _size );
+            for ( const auto& e : *this )
+               result.push_back( e );
+            return result;
+         }
+
+         /**
+          * Get the packed elements, without the leading element count
+          */
+         const std::vector<char>& packed_data()const { return _data; }
+
+         /**
+          *  Serialize a lazy_vector, the same as a std::vector holding its elements
+          *
+          *  @param ds - The stream to write
+          *  @param v - The value to serialize
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator<<( DataStream& ds, const lazy_vector& v ) {
+            ds << unsigned_int( v._size );
+            ds.write( v._data.data(), v._data.size() );
+            return ds;
+         }
+
+         /**
+          *  Deserialize a lazy_vector from a packed std::vector<T>, keeping the elements packed
+          *
+          *  @param ds - The stream to read
+          *  @param v - The destination for deserialized value
+          *  @tparam DataStream - Type of datastream
+          *  @return DataStream& - Reference to the datastream
+          */
+         template<typename DataStream>
+         friend DataStream& operator>>( DataStream& ds, lazy_vector& v ) {
+            unsigned_int s;
+            ds >> s;
+            const char* start = ds.pos();
+            if constexpr ( has_fixed_pack_size_v<T> ) {
+               eosio::check( fixed_pack_size_v<T> == 0 || s.value <= ds.remaining() / fixed_pack_size_v<T>, "read" );
+               ds.skip( s.value * fixed_pack_size_v<T> );
+            } else {
+               for ( uint32_t i = 0; i < s.value; ++i )
+                  _datastream_detail::skip_packed<T>( ds );
+            }
+            v._data.assign( start, static_cast<const char*>(ds.pos()) );
+            v._size = s.value;
+            return ds;
+         }
+
+      private:
+         std::vector<char> _data;
+         uint32_t          _size = 0;
+   };
+} // namespace eosio
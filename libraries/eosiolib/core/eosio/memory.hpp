@@ -0,0 +1,107 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eosio {
+   /**
+    * Word at a time implementations behind memcpy, memmove, memset and memcmp in eosio_cmem.
+    *
+    * Bulk memory instructions are not available to contracts, so runs of 16 bytes or more are moved
+    * 8 bytes at a time with the destination aligned, and the head and tail are done bytewise. Unaligned
+    * word loads are well defined in wasm and cheap on the native targets.
+    *
+    * These must be compiled with -fno-builtin, otherwise the tail loops can be turned back into calls
+    * to the functions they implement.
+    */
+   namespace _memory_detail {
+      typedef uint64_t __attribute__((__may_alias__)) word;
+      typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) unaligned_word;
+
+      static constexpr size_t word_size       = sizeof(word);
+      static constexpr size_t word_threshold  = 2*word_size;
+
+      inline bool is_aligned( const void* ptr ) {
+         return (reinterpret_cast<uintptr_t>(ptr) & (word_size-1)) == 0;
+      }
+
+      /// copies front to back, safe for overlapping ranges when dest is below src
+      inline void copy_forward( uint8_t* dest, const uint8_t* src, size_t n ) {
+         if ( n >= word_threshold ) {
+            for ( ; !is_aligned(dest); --n )
+               *dest++ = *src++;
+            for ( ; n >= 4*word_size; n -= 4*word_size, dest += 4*word_size, src += 4*word_size ) {
+               word w0 = reinterpret_cast<const unaligned_word*>(src)[0];
+               word w1 = reinterpret_cast<const unaligned_word*>(src)[1];
+               word w2 = reinterpret_cast<const unaligned_word*>(src)[2];
+               word w3 = reinterpret_cast<const unaligned_word*>(src)[3];
+               reinterpret_cast<word*>(dest)[0] = w0;
+               reinterpret_cast<word*>(dest)[1] = w1;
+               reinterpret_cast<word*>(dest)[2] = w2;
+               reinterpret_cast<word*>(dest)[3] = w3;
+            }
+            for ( ; n >= word_size; n -= word_size, dest += word_size, src += word_size )
+               *reinterpret_cast<word*>(dest) = *reinterpret_cast<const unaligned_word*>(src);
+         }
+         for ( ; n; --n )
+            *dest++ = *src++;
+      }
+
+      /// copies back to front, safe for overlapping ranges when dest is above src
+      inline void copy_backward( uint8_t* dest, const uint8_t* src, size_t n ) {
+         dest += n;
+         src  += n;
+         if ( n >= word_threshold ) {
+            for ( ; !is_aligned(dest); --n )
+               *--dest = *--src;
+            for ( ; n >= word_size; n -= word_size ) {
+               dest -= word_size;
+               src  -= word_size;
+               *reinterpret_cast<word*>(dest) = *reinterpret_cast<const unaligned_word*>(src);
+            }
+         }
+         for ( ; n; --n )
+            *--dest = *--src;
+      }
+
+      inline void move( uint8_t* dest, const uint8_t* src, size_t n ) {
+         if ( dest == src || n == 0 )
+            return;
+         // a forward copy is only unsafe when dest starts inside the source range
+         if ( dest < src || dest >= src + n )
+            copy_forward( dest, src, n );
+         else
+            copy_backward( dest, src, n );
+      }
+
+      inline void fill( uint8_t* dest, uint8_t c, size_t n ) {
+         if ( n >= word_threshold ) {
+            for ( ; !is_aligned(dest); --n )
+               *dest++ = c;
+            const word w = word(c) * 0x0101010101010101ull;
+            for ( ; n >= word_size; n -= word_size, dest += word_size )
+               *reinterpret_cast<word*>(dest) = w;
+         }
+         for ( ; n; --n )
+            *dest++ = c;
+      }
+
+      inline int compare( const uint8_t* p1, const uint8_t* p2, size_t n ) {
+         // skip equal words, the first differing word is then resolved bytewise
+         for ( ; n >= word_size; n -= word_size, p1 += word_size, p2 += word_size )
+            if ( *reinterpret_cast<const unaligned_word*>(p1) != *reinterpret_cast<const unaligned_word*>(p2) )
+               break;
+         for ( ; n; --n, ++p1, ++p2 ) {
+            if ( *p1 < *p2 )
+               return -1;
+            else if ( *p1 > *p2 )
+               return 1;
+         }
+         return 0;
+      }
+   }
+}
@@ -6,9 +6,14 @@
 
 #include "check.hpp"
 #include "serialize.hpp"
+#include "datastream.hpp"
+#include "print.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace eosio {
    namespace internal_use_do_not_use {
@@ -25,6 +30,77 @@ namespace eosio {
     * @brief EOSIO Name Type
     */
 
+   /// @cond IMPLEMENTATIONS
+
+   // Word parallel (SWAR) conversion between name characters and their 5 bit values. A word holds up to eight
+   // characters, the first one in its lowest byte, which is the order they have in memory on little endian targets.
+   namespace _name_detail {
+      constexpr uint64_t ones = 0x0101010101010101ull;
+      constexpr uint64_t highs = 0x8080808080808080ull;
+
+      // 0x80 in every byte of the 7 bit bytes of x that are >= c
+      constexpr uint64_t bytes_at_least( uint64_t x, uint8_t c ) {
+         return ((x | highs) - ones * c) & highs;
+      }
+
+      // the first n chars of str, then dots, in a word
+      constexpr uint64_t load_chars( std::string_view str, size_t first, size_t n ) {
+         uint64_t w = 0;
+         for( size_t i = 0; i < 8; ++i )
+            w |= uint64_t(uint8_t(first + i < n ? str[first + i] : '.')) << (8 * i);
+         return w;
+      }
+
+      // 0x80 in every byte of w that is not a name character
+      constexpr uint64_t invalid_chars( uint64_t w ) {
+         const uint64_t x      = w & ~highs;
+         const uint64_t digit  = bytes_at_least( x, '1' ) & ~bytes_at_least( x, '6' );
+         const uint64_t letter = bytes_at_least( x, 'a' ) & ~bytes_at_least( x, '{' );
+         const uint64_t dot    = ~bytes_at_least( x ^ (ones * '.'), 1 ) & highs;
+         return (w & highs) | (~(digit | letter | dot) & highs);
+      }
+
+      // the 5 bit values of a word of valid name characters, one per byte
+      constexpr uint64_t chars_to_values( uint64_t w ) {
+         const uint64_t digit  = bytes_at_least( w, '1' ) & ~bytes_at_least( w, '6' );
+         const uint64_t letter = bytes_at_least( w, 'a' );
+         return ((((w | highs) - ones * ('1' - 1)) & (digit >> 7) * 0xFF) |
+                 (((w | highs) - ones * ('a' - 6)) & (letter >> 7) * 0xFF)) & (ones * 0x1F);
+      }
+
+      // packs eight 5 bit values, one per byte, into 40 bits with the first byte most significant
+      constexpr uint64_t pack_values( uint64_t v ) {
+         v = ((v & 0x00FF00FF00FF00FFull) << 5)  | ((v >> 8)  & 0x00FF00FF00FF00FFull);
+         v = ((v & 0x0000FFFF0000FFFFull) << 10) | ((v >> 16) & 0x0000FFFF0000FFFFull);
+         return ((v & 0xFFFFFFFFull) << 20) | (v >> 32);
+      }
+
+      // inverse of pack_values
+      constexpr uint64_t unpack_values( uint64_t v ) {
+         v = (v >> 20) | ((v & 0xFFFFFull) << 32);
+         v = ((v >> 10) & 0x000003FF000003FFull) | ((v & 0x000003FF000003FFull) << 16);
+         return ((v >> 5) & 0x001F001F001F001Full) | ((v & 0x001F001F001F001Full) << 8);
+      }
+
+      // the name characters of a word of 5 bit values
+      constexpr uint64_t values_to_chars( uint64_t v ) {
+         const uint64_t letter = (v + ones * (0x80 - 6)) & highs;
+         const uint64_t dot    = ~(v + ones * 0x7F) & highs;
+         return v + ones * '0' + (letter >> 7) * ('a' - 6 - '0') - (dot >> 7) * ('0' - '.');
+      }
+
+      // number of characters up to the last one that is not a dot
+      constexpr uint8_t length( uint64_t value ) {
+         if( value == 0 )
+            return 0;
+         if( value & 0x0Full )
+            return 13;
+         return (63 - __builtin_ctzll( value )) / 5 + 1;
+      }
+   }
+
+   /// @endcond
+
    /**
     * Wraps a %uint64_t to ensure it is only passed to methods that expect a %name.
     * Ensures value is only passed to methods that expect a %name and that no mathematical
@@ -83,12 +159,15 @@ namespace eosio {
             return;
          }
 
-         auto n = std::min( (uint32_t)str.size(), (uint32_t)12u );
-         for( decltype(n) i = 0; i < n; ++i ) {
-            value <<= 5;
-            value |= char_to_value( str[i] );
+         // the first twelve characters eight and four at a time, padded with dots
+         const size_t n = std::min( str.size(), size_t(12) );
+         const uint64_t first  = _name_detail::load_chars( str, 0, n );
+         const uint64_t second = _name_detail::load_chars( str, 8, n ) & 0xFFFFFFFFull;
+         if( _name_detail::invalid_chars( first ) | (_name_detail::invalid_chars( second ) & 0xFFFFFFFFull) ) {
+            eosio::check( false, "character is not in allowed character set for names" );
          }
-         value <<= ( 4 + 5*(12 - n) );
+         value = _name_detail::pack_values( _name_detail::chars_to_values( first ) ) << 24 |
+                 _name_detail::pack_values( _name_detail::chars_to_values( second ) ) >> 16;
          if( str.size() == 13 ) {
             uint64_t v = char_to_value( str[12] );
             if( v > 0x0Full ) {
@@ -121,20 +200,7 @@ namespace eosio {
        *  Returns the length of the %name
        */
       constexpr uint8_t length()const {
-         constexpr uint64_t mask = 0xF800000000000000ull;
-
-         if( value == 0 )
-            return 0;
-
-         uint8_t l = 0;
-         uint8_t i = 0;
-         for( auto v = value; i < 13; ++i, v <<= 5 ) {
-            if( (v & mask) > 0 ) {
-               l = i;
-            }
-         }
-
-         return l + 1;
+         return _name_detail::length( value );
       }
 
       /**
@@ -195,21 +261,15 @@ namespace eosio {
        *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the %name.
        */
       char* write_as_string( char* begin, char* end )const {
-         static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
-         constexpr uint64_t mask = 0xF800000000000000ull;
-
          if( (begin + 13) < begin || (begin + 13) > end ) return begin;
 
-         auto v = value;
-         for( auto i = 0;   i < 13; ++i, v <<= 5 ) {
-            if( v == 0 ) return begin;
-
-            auto indx = (v & mask) >> (i == 12 ? 60 : 59);
-            *begin = charmap[indx];
-            ++begin;
-         }
-
-         return begin;
+         // all thirteen characters are written, the trailing dots are then left out of the returned range
+         const uint64_t first  = _name_detail::values_to_chars( _name_detail::unpack_values( value >> 24 ) );
+         const uint64_t second = _name_detail::values_to_chars( _name_detail::unpack_values( (value >> 4 & 0xFFFFFull) << 20 ) );
+         memcpy( begin, &first, 8 );
+         memcpy( begin + 8, &second, 4 );
+         begin[12] = char( _name_detail::values_to_chars( value & 0x0Full ) );
+         return begin + _name_detail::length( value );
       }
 
       /**
@@ -232,6 +292,15 @@ namespace eosio {
         internal_use_do_not_use::printn(value);
       }
 
+      /**
+       * Renders the name into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       */
+      inline void print( print_buffer& buf )const {
+         buf.write( 13, [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
+      }
+
       /// @cond INTERNAL
 
       /**
@@ -268,6 +337,96 @@ namespace eosio {
       EOSLIB_SERIALIZE( name, (value) )
    };
 
+   /**
+    * Checks whether a string is a valid %name, that is one name(std::string_view) accepts
+    *
+    * @ingroup name
+    * @param str - The string to check
+    * @return true if the string converts to a %name
+    */
+   constexpr bool is_valid_name( std::string_view str ) {
+      if( str.size() > 13 )
+         return false;
+      const size_t n = std::min( str.size(), size_t(12) );
+      if( _name_detail::invalid_chars( _name_detail::load_chars( str, 0, n ) ) |
+          (_name_detail::invalid_chars( _name_detail::load_chars( str, 8, n ) ) & 0xFFFFFFFFull) )
+         return false;
+      if( str.size() == 13 ) {
+         const char c = str[12];
+         return c == '.' || ('1' <= c && c <= '5') || ('a' <= c && c <= 'j');
+      }
+      return true;
+   }
+
+   /**
+    *  Writes names as strings separated by a character to the provided char buffer
+    *
+    *  @ingroup name
+    *  @pre Appropriate Size Precondition: (begin + 14 * (last - first)) <= end and (begin + 14 * (last - first)) does not overflow
+    *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+    *  @param first - The first of the names
+    *  @param last - Just past the last of the names
+    *  @param begin - The start of the char buffer
+    *  @param end - Just past the end of the char buffer
+    *  @param separator - The character written between two names
+    *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+    */
+   inline char* write_names_as_string( const name* first, const name* last, char* begin, char* end, char separator = ',' ) {
+      const size_t size = 14 * size_t(last - first);
+      if( (begin + size) < begin || (begin + size) > end ) return begin;
+
+      for( auto it = first; it != last; ++it ) {
+         if( it != first )
+            *begin++ = separator;
+         begin = it->write_as_string( begin, begin + 13 );
+      }
+      return begin;
+   }
+
+   /**
+    * Returns names as one string in which they are separated by a character
+    *
+    * @ingroup name
+    * @param names - The names to convert
+    * @param separator - The character written between two names
+    */
+   inline std::string names_to_string( const std::vector<name>& names, char separator = ',' ) {
+      std::string str( 14 * names.size(), '\0' );
+      char* end = write_names_as_string( names.data(), names.data() + names.size(), str.data(), str.data() + str.size(), separator );
+      str.resize( end - str.data() );
+      return str;
+   }
+
+   /**
+    * Converts a string of names separated by a character, an empty string has no names
+    *
+    * @ingroup name
+    * @param str - The string to convert
+    * @param separator - The character between two names
+    * @pre Every name in str is valid, as checked by name(std::string_view)
+    */
+   inline std::vector<name> names_from_string( std::string_view str, char separator = ',' ) {
+      std::vector<name> names;
+      if( str.empty() )
+         return names;
+      names.reserve( std::count( str.begin(), str.end(), separator ) + 1 );
+      for( size_t pos = 0;; ) {
+         const size_t next = str.find( separator, pos );
+         names.emplace_back( str.substr( pos, next == std::string_view::npos ? std::string_view::npos : next - pos ) );
+         if( next == std::string_view::npos )
+            return names;
+         pos = next + 1;
+      }
+   }
+
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(name) == sizeof(uint64_t), "name must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<name> : std::true_type {};
+
+   /// @endcond
+
    namespace detail {
       template <char... Str>
       struct to_const_char_arr {
@@ -3,9 +3,11 @@
  *  @copyright defined in eos/LICENSE
  */
 #pragma once
+#include <cstring>
 #include <utility>
 #include <string>
-
+#include <string_view>
+#include <type_traits>
 
 
 namespace eosio {
@@ -67,6 +69,154 @@ namespace eosio {
     *  2. implement T::print()const
     */
 
+   /**
+    *  A stack buffer that collects console output and prints it with a single prints_l
+    *
+    *  The variadic print() and print_f() render all of their arguments into one print_buffer, so a whole
+    *  debug line costs one intrinsic call instead of one per argument. Types can render themselves into it
+    *  by implementing `void print( print_buffer& )const` next to their `print()const`, types without it are
+    *  printed through print() after flushing what was collected so far. The buffer is flushed when it
+    *  fills up and when it is destroyed.
+    *
+    *  @ingroup console
+    */
+   class print_buffer {
+      public:
+         static constexpr size_t capacity = 512;
+
+         print_buffer() = default;
+         print_buffer( const print_buffer& ) = delete;
+         print_buffer& operator=( const print_buffer& ) = delete;
+         ~print_buffer() { flush(); }
+
+         /**
+          *  Prints the collected output and empties the buffer
+          */
+         void flush() {
+            if( _end != _buf ) {
+               internal_use_do_not_use::prints_l( _buf, _end - _buf );
+               _end = _buf;
+            }
+         }
+
+         /**
+          *  Appends a string, strings longer than the capacity are printed directly
+          *
+          *  @param ptr - The start of the string
+          *  @param len - The number of chars to append
+          */
+         void append( const char* ptr, size_t len ) {
+            if( len > capacity - size() ) {
+               flush();
+               if( len > capacity ) {
+                  internal_use_do_not_use::prints_l( ptr, len );
+                  return;
+               }
+            }
+            memcpy( _end, ptr, len );
+            _end += len;
+         }
+
+         /**
+          *  Renders at most max_len chars in place with a write_as_string style function
+          *
+          *  @param max_len - The most chars write can produce, at most capacity
+          *  @param write - Called as `char* write( char* begin, char* end )`, returns just past the last char written
+          */
+         template<typename Write>
+         void write( size_t max_len, Write&& write ) {
+            if( max_len > capacity - size() )
+               flush();
+            _end = write( _end, _end + max_len );
+         }
+
+         size_t size()const { return _end - _buf; }
+
+      private:
+         char  _buf[capacity];
+         char* _end = _buf;
+   };
+
+   /// @cond IMPLEMENTATIONS
+
+   namespace _print_detail {
+      inline constexpr char digit_pairs[] =
+         "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+         "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+         "8081828384858687888990919293949596979899";
+
+      inline size_t count_digits( uint64_t v ) {
+         size_t n = 1;
+         for( ;; n += 4, v /= 10000 ) {
+            if( v < 10 )    return n;
+            if( v < 100 )   return n + 1;
+            if( v < 1000 )  return n + 2;
+            if( v < 10000 ) return n + 3;
+         }
+      }
+
+      // writes the decimal digits of v two at a time from the back, returns just past the last one
+      inline char* write_decimal( char* begin, uint64_t v ) {
+         char* const end = begin + count_digits( v );
+         char* pos = end;
+         while( v >= 100 ) {
+            const char* pair = digit_pairs + (v % 100) * 2;
+            v /= 100;
+            *--pos = pair[1];
+            *--pos = pair[0];
+         }
+         if( v >= 10 ) {
+            *--pos = digit_pairs[v * 2 + 1];
+            *--pos = digit_pairs[v * 2];
+         } else {
+            *--pos = '0' + v;
+         }
+         return end;
+      }
+
+      inline char* write_signed_decimal( char* begin, int64_t v ) {
+         if( v < 0 ) {
+            *begin++ = '-';
+            return write_decimal( begin, uint64_t(0) - uint64_t(v) );
+         }
+         return write_decimal( begin, uint64_t(v) );
+      }
+
+      // writes the low width decimal digits of v, zero padded
+      inline char* write_digits( char* begin, uint64_t v, size_t width ) {
+         char* pos = begin + width;
+         for( ; pos - begin >= 2 && v; v /= 100 ) {
+            const char* pair = digit_pairs + (v % 100) * 2;
+            *--pos = pair[1];
+            *--pos = pair[0];
+         }
+         if( pos != begin && v )
+            *--pos = '0' + v % 10;
+         if( pos != begin )
+            memset( begin, '0', pos - begin );
+         return begin + width;
+      }
+
+      inline char* write_hex( char* begin, const void* ptr, size_t size ) {
+         static const char hex_chars[] = "0123456789abcdef";
+         const unsigned char* bytes = static_cast<const unsigned char*>(ptr);
+         for( size_t i = 0; i < size; ++i ) {
+            *begin++ = hex_chars[bytes[i] >> 4];
+            *begin++ = hex_chars[bytes[i] & 0xf];
+         }
+         return begin;
+      }
+
+      template<typename T, typename = void>
+      struct has_buffered_print : std::false_type {};
+
+      template<typename T>
+      struct has_buffered_print<T, std::void_t<decltype(std::declval<const T&>().print(std::declval<print_buffer&>()))>>
+         : std::true_type {};
+   }
+
+   /// @endcond
+
    /**
     *  Prints a block of bytes in hexadecimal
     *
@@ -172,6 +322,43 @@ namespace eosio {
          t.print();
    }
 
+   /**
+    *  Renders a value into a print_buffer
+    *
+    *  Strings, chars, bools, integers up to 64 bits and types implementing `print( print_buffer& )const` are
+    *  formatted in the buffer, anything else is printed through print() after flushing the buffer.
+    *
+    *  @ingroup console
+    *  @param buf - The buffer to render into
+    *  @param v - The value to be printed
+    */
+   template<typename T>
+   inline void print_to( print_buffer& buf, T&& v ) {
+      using U = std::decay_t<T>;
+      if constexpr( std::is_same<U, const char*>::value || std::is_same<U, char*>::value ) {
+         buf.append( v, strlen(v) );
+      } else if constexpr( std::is_same<U, std::string>::value || std::is_same<U, std::string_view>::value ) {
+         buf.append( v.data(), v.size() );
+      } else if constexpr( std::is_same<U, bool>::value ) {
+         if( v )
+            buf.append( "true", 4 );
+         else
+            buf.append( "false", 5 );
+      } else if constexpr( std::is_same<U, char>::value ) {
+         buf.append( &v, 1 );
+      } else if constexpr( std::is_integral<U>::value && sizeof(U) <= sizeof(uint64_t) && std::is_signed<U>::value ) {
+         buf.write( 20, [&]( char* begin, char* ) { return _print_detail::write_signed_decimal( begin, v ); } );
+      } else if constexpr( std::is_integral<U>::value && sizeof(U) <= sizeof(uint64_t) ) {
+         buf.write( 20, [&]( char* begin, char* ) { return _print_detail::write_decimal( begin, v ); } );
+      } else if constexpr( _print_detail::has_buffered_print<U>::value ) {
+         v.print( buf );
+      } else {
+         // floating point and 128 bit numbers keep the host's formatting
+         buf.flush();
+         print( std::forward<T>(v) );
+      }
+   }
+
    /**
     *  Prints null terminated string
     *
@@ -182,6 +369,28 @@ namespace eosio {
      internal_use_do_not_use::prints(s);
    }
 
+   /// @cond IMPLEMENTATIONS
+
+   namespace _print_detail {
+      inline void format_to( print_buffer& buf, const char* s ) {
+         buf.append( s, strlen(s) );
+      }
+
+      template <typename Arg, typename... Args>
+      inline void format_to( print_buffer& buf, const char* s, Arg&& val, Args&&... rest ) {
+         const char* spec = strchr( s, '%' );
+         if( !spec ) {
+            format_to( buf, s );
+            return;
+         }
+         buf.append( s, spec - s );
+         print_to( buf, std::forward<Arg>(val) );
+         format_to( buf, spec + 1, std::forward<Args>(rest)... );
+      }
+   }
+
+   /// @endcond
+
    /**
     *  Prints formatted string. It behaves similar to C printf/
     *
@@ -198,15 +407,8 @@ namespace eosio {
     */
    template <typename Arg, typename... Args>
    inline void print_f( const char* s, Arg val, Args... rest ) {
-      while ( *s != '\0' ) {
-         if ( *s == '%' ) {
-            print( val );
-            print_f( s+1, rest... );
-            return;
-         }
-         internal_use_do_not_use::prints_l( s, 1 );
-         s++;
-      }
+      print_buffer buf;
+      _print_detail::format_to( buf, s, val, rest... );
    }
 
     /**
@@ -230,8 +432,9 @@ namespace eosio {
      */
    template<typename Arg, typename... Args>
    void print( Arg&& a, Args&&... args ) {
-      print(std::forward<Arg>(a));
-      print(std::forward<Args>(args)...);
+      print_buffer buf;
+      print_to( buf, std::forward<Arg>(a) );
+      ( print_to( buf, std::forward<Args>(args) ), ... );
    }
 
    /**
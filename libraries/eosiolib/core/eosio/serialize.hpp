@@ -4,9 +4,34 @@
 #include <boost/preprocessor/seq/seq.hpp>
 #include <boost/preprocessor/stringize.hpp>
 
+#include "datastream.hpp"
+
 #define EOSLIB_REFLECT_MEMBER_OP( r, OP, elem ) \
   OP t.elem
 
+#define EOSLIB_REFLECT_MEMBER_ARG( r, OBJ, elem ) \
+  , OBJ.elem
+
+#define EOSLIB_REFLECT_MEMBER_SIZE( r, SELF, elem ) \
+  , ::eosio::fixed_pack_size<::eosio::_datastream_detail::field_type<decltype(std::declval<const SELF&>().elem)>>::value
+
+/// fixed_pack_size hook, a template so that it is not picked up for classes deriving from TYPE
+#define EOSLIB_FIXED_PACK_SIZE( TYPE, BASE_SIZE, MEMBERS ) \
+ template<typename Self, std::enable_if_t<std::is_same<Self, TYPE>::value>* = nullptr> \
+ friend constexpr size_t eosio_fixed_pack_size( const Self* ){ \
+    return ::eosio::_datastream_detail::sum_fixed_sizes({ BASE_SIZE BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_SIZE, Self, MEMBERS ) }); \
+ }
+
+#define EOSLIB_REFLECT_MEMBER_TYPE( r, SELF, elem ) \
+  , ::eosio::_datastream_detail::field_type<decltype(std::declval<const SELF&>().elem)>
+
+/// skip hook, walks the packed members without decoding them
+#define EOSLIB_SKIP_PACKED( TYPE, BASE, MEMBERS ) \
+ template<typename DataStream, typename Self, std::enable_if_t<std::is_same<Self, TYPE>::value>* = nullptr> \
+ friend void eosio_skip_packed( DataStream& ds, const Self* ){ \
+    ::eosio::_datastream_detail::skip_fields<DataStream, BASE BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_TYPE, Self, MEMBERS )>( ds ); \
+ }
+
 /**
  *  @defgroup serialize Serialize
  *  @ingroup core
@@ -23,12 +48,14 @@
 #define EOSLIB_SERIALIZE( TYPE,  MEMBERS ) \
  template<typename DataStream> \
  friend DataStream& operator << ( DataStream& ds, const TYPE& t ){ \
-    return ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_OP, <<, MEMBERS );\
+    return ::eosio::_datastream_detail::write_fields( ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_ARG, t, MEMBERS ) );\
  }\
  template<typename DataStream> \
  friend DataStream& operator >> ( DataStream& ds, TYPE& t ){ \
-    return ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_OP, >>, MEMBERS );\
- }
+    return ::eosio::_datastream_detail::read_fields( ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_ARG, t, MEMBERS ) );\
+ }\
+ EOSLIB_FIXED_PACK_SIZE( TYPE, size_t(0), MEMBERS )\
+ EOSLIB_SKIP_PACKED( TYPE, void, MEMBERS )
 
 /**
  *  Defines serialization and deserialization for a class which inherits from other classes that
@@ -42,11 +69,11 @@
 #define EOSLIB_SERIALIZE_DERIVED( TYPE, BASE, MEMBERS ) \
  template<typename DataStream> \
  friend DataStream& operator << ( DataStream& ds, const TYPE& t ){ \
-    ds << static_cast<const BASE&>(t); \
-    return ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_OP, <<, MEMBERS );\
+    return ::eosio::_datastream_detail::write_fields( ds, static_cast<const BASE&>(t) BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_ARG, t, MEMBERS ) );\
  }\
  template<typename DataStream> \
  friend DataStream& operator >> ( DataStream& ds, TYPE& t ){ \
-    ds >> static_cast<BASE&>(t); \
-    return ds BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_OP, >>, MEMBERS );\
- }
+    return ::eosio::_datastream_detail::read_fields( ds, static_cast<BASE&>(t) BOOST_PP_SEQ_FOR_EACH( EOSLIB_REFLECT_MEMBER_ARG, t, MEMBERS ) );\
+ }\
+ EOSLIB_FIXED_PACK_SIZE( TYPE, ::eosio::fixed_pack_size<BASE>::value, MEMBERS )\
+ EOSLIB_SKIP_PACKED( TYPE, BASE, MEMBERS )
@@ -169,6 +169,15 @@ namespace eosio {
            printl( buffer, (end-buffer) );
       }
 
+      /**
+       * Renders the symbol_code into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       */
+      inline void print( print_buffer& buf )const {
+         buf.write( 7, [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
+      }
+
       /**
        * Equivalency operator. Returns true if a == b (are the same)
        *
@@ -231,6 +240,14 @@ namespace eosio {
      return ds;
    }
 
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(symbol_code) == sizeof(uint64_t), "symbol_code must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<symbol_code> : std::true_type {};
+
+   /// @endcond
+
    /**
     *  Stores information about a symbol, the symbol can be 7 characters long.
     *
@@ -296,13 +313,50 @@ namespace eosio {
        * %Print the symbol
        */
       void print( bool show_precision = true )const {
-         if( show_precision ){
-            ::eosio::print( static_cast<uint64_t>(precision()), "," );
+         print_buffer buf;
+         print( buf, show_precision );
+      }
+
+      /**
+       * Renders the symbol into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       * @param show_precision - Whether to prefix the code with the precision and a comma
+       */
+      void print( print_buffer& buf, bool show_precision = true )const {
+         buf.write( 11, [&]( char* begin, char* end ) { return write_as_string( begin, end, show_precision ); } );
+      }
+
+      /**
+       *  Writes the symbol as a string to the provided char buffer
+       *
+       *  @pre Appropriate Size Precondition: (begin + 11) <= end and (begin + 11) does not overflow
+       *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+       *  @param begin - The start of the char buffer
+       *  @param end - Just past the end of the char buffer
+       *  @param show_precision - Whether to prefix the code with the precision and a comma
+       *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+       *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the symbol.
+       */
+      char* write_as_string( char* begin, char* end, bool show_precision = true )const {
+         if( (begin + 11) < begin || (begin + 11) > end ) return begin;
+
+         if( show_precision ) {
+            begin = _print_detail::write_decimal( begin, precision() );
+            *begin++ = ',';
          }
-         char buffer[7];
-         auto end = code().write_as_string( buffer, buffer + sizeof(buffer) );
-         if( buffer < end )
-            ::eosio::print( buffer, (end-buffer) );
+         return code().write_as_string( begin, begin + 7 );
+      }
+
+      /**
+       * Returns the symbol as a string, by default as its precision, a comma and its code
+       *
+       * @param show_precision - Whether to prefix the code with the precision and a comma
+       */
+      std::string to_string( bool show_precision = true )const {
+         char buffer[11];
+         auto end = write_as_string( buffer, buffer + sizeof(buffer), show_precision );
+         return {buffer, end};
       }
 
       /**
@@ -369,6 +423,14 @@ namespace eosio {
      return ds;
    }
 
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(symbol) == sizeof(uint64_t), "symbol must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<symbol> : std::true_type {};
+
+   /// @endcond
+
    /**
     *  Extended asset which stores the information of the owner of the symbol
     *
@@ -411,8 +473,20 @@ namespace eosio {
        * @brief %Print the extended symbol
        */
       void print( bool show_precision = true )const {
-         symbol.print( show_precision );
-         ::eosio::print("@", contract);
+         print_buffer buf;
+         print( buf, show_precision );
+      }
+
+      /**
+       * Renders the extended symbol into a print_buffer
+       *
+       * @param buf - The buffer to render into
+       * @param show_precision - Whether to prefix the code with the precision and a comma
+       */
+      void print( print_buffer& buf, bool show_precision = true )const {
+         symbol.print( buf, show_precision );
+         buf.append( "@", 1 );
+         contract.print( buf );
       }
 
       /**
@@ -448,4 +522,12 @@ namespace eosio {
 
       EOSLIB_SERIALIZE( extended_symbol, (symbol)(contract) )
    };
+
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(extended_symbol) == sizeof(symbol) + sizeof(name), "extended_symbol must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<extended_symbol> : std::true_type {};
+
+   /// @endcond
 }
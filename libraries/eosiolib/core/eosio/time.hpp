@@ -2,6 +2,8 @@
 #include <stdint.h>
 #include <string>
 #include "serialize.hpp"
+#include "datastream.hpp"
+#include "print.hpp"
 
 namespace eosio {
   /**
@@ -10,6 +12,61 @@ namespace eosio {
    *  @brief Classes for working with time.
    */
 
+  /// @cond IMPLEMENTATIONS
+
+  namespace _time_detail {
+     // writes seconds since 1970 as YYYY-MM-DDTHH:MM:SS, days to civil date as in
+     // http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+     inline char* write_date_time( char* begin, int64_t sec ) {
+        int64_t days = sec / 86400;
+        int64_t rem  = sec % 86400;
+        if( rem < 0 ) {
+           rem += 86400;
+           --days;
+        }
+        days += 719468;
+        const int64_t  era = (days >= 0 ? days : days - 146096) / 146097;
+        const uint64_t doe = uint64_t(days - era * 146097);
+        const uint64_t yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+        const uint64_t doy = doe - (365*yoe + yoe/4 - yoe/100);
+        const uint64_t mp  = (5*doy + 2) / 153;
+        const uint64_t day = doy - (153*mp + 2)/5 + 1;
+        const uint64_t month = mp < 10 ? mp + 3 : mp - 9;
+        int64_t year = int64_t(yoe) + era * 400 + (month <= 2);
+
+        if( year < 0 ) {
+           *begin++ = '-';
+           year = -year;
+        }
+        begin = year < 10000 ? _print_detail::write_digits( begin, year, 4 ) : _print_detail::write_decimal( begin, year );
+        *begin++ = '-';
+        begin = _print_detail::write_digits( begin, month, 2 );
+        *begin++ = '-';
+        begin = _print_detail::write_digits( begin, day, 2 );
+        *begin++ = 'T';
+        begin = _print_detail::write_digits( begin, rem / 3600, 2 );
+        *begin++ = ':';
+        begin = _print_detail::write_digits( begin, rem / 60 % 60, 2 );
+        *begin++ = ':';
+        return _print_detail::write_digits( begin, rem % 60, 2 );
+     }
+
+     // writes microseconds since 1970 as YYYY-MM-DDTHH:MM:SS.sss
+     inline char* write_date_time_ms( char* begin, int64_t usec ) {
+        int64_t sec  = usec / 1000000;
+        int64_t frac = usec % 1000000;
+        if( frac < 0 ) {
+           frac += 1000000;
+           --sec;
+        }
+        begin = write_date_time( begin, sec );
+        *begin++ = '.';
+        return _print_detail::write_digits( begin, frac / 1000, 3 );
+     }
+  }
+
+  /// @endcond
+
 
 
   class microseconds {
@@ -73,6 +130,47 @@ namespace eosio {
         microseconds elapsed;
         /// @endcond
 
+        /**
+         *  Writes the time_point as YYYY-MM-DDTHH:MM:SS.sss in UTC to the provided char buffer
+         *
+         *  @pre Appropriate Size Precondition: (begin + 26) <= end and (begin + 26) does not overflow
+         *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+         *  @param begin - The start of the char buffer
+         *  @param end - Just past the end of the char buffer
+         *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+         *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the time_point.
+         */
+        char* write_as_string( char* begin, char* end )const {
+           if( (begin + 26) < begin || (begin + 26) > end ) return begin;
+           return _time_detail::write_date_time_ms( begin, elapsed.count() );
+        }
+
+        /**
+         * Returns the time_point as YYYY-MM-DDTHH:MM:SS.sss in UTC
+         */
+        std::string to_string()const {
+           char buffer[26];
+           auto end = write_as_string( buffer, buffer + sizeof(buffer) );
+           return {buffer, end};
+        }
+
+        /**
+         * Prints the time_point as YYYY-MM-DDTHH:MM:SS.sss
+         */
+        void print()const {
+           print_buffer buf;
+           print( buf );
+        }
+
+        /**
+         * Renders the time_point into a print_buffer as YYYY-MM-DDTHH:MM:SS.sss
+         *
+         * @param buf - The buffer to render into
+         */
+        void print( print_buffer& buf )const {
+           buf.write( 26, [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
+        }
+
         EOSLIB_SERIALIZE( time_point, (elapsed) )
   };
 
@@ -128,6 +226,47 @@ namespace eosio {
 
         /// @endcond
 
+        /**
+         *  Writes the time_point_sec as YYYY-MM-DDTHH:MM:SS in UTC to the provided char buffer
+         *
+         *  @pre Appropriate Size Precondition: (begin + 19) <= end and (begin + 19) does not overflow
+         *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+         *  @param begin - The start of the char buffer
+         *  @param end - Just past the end of the char buffer
+         *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+         *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the time_point_sec.
+         */
+        char* write_as_string( char* begin, char* end )const {
+           if( (begin + 19) < begin || (begin + 19) > end ) return begin;
+           return _time_detail::write_date_time( begin, utc_seconds );
+        }
+
+        /**
+         * Returns the time_point_sec as YYYY-MM-DDTHH:MM:SS in UTC
+         */
+        std::string to_string()const {
+           char buffer[19];
+           auto end = write_as_string( buffer, buffer + sizeof(buffer) );
+           return {buffer, end};
+        }
+
+        /**
+         * Prints the time_point_sec as YYYY-MM-DDTHH:MM:SS
+         */
+        void print()const {
+           print_buffer buf;
+           print( buf );
+        }
+
+        /**
+         * Renders the time_point_sec into a print_buffer as YYYY-MM-DDTHH:MM:SS
+         *
+         * @param buf - The buffer to render into
+         */
+        void print( print_buffer& buf )const {
+           buf.write( 19, [&]( char* begin, char* end ) { return write_as_string( begin, end ); } );
+        }
+
         EOSLIB_SERIALIZE( time_point_sec, (utc_seconds) )
   };
 
@@ -186,6 +325,43 @@ namespace eosio {
          static constexpr int64_t block_timestamp_epoch = 946684800000ll;  // epoch is year 2000
          /// @endcond
 
+         /**
+          *  Writes the time of the block slot as YYYY-MM-DDTHH:MM:SS.sss in UTC to the provided char buffer
+          *
+          *  @pre Appropriate Size Precondition: (begin + 26) <= end and (begin + 26) does not overflow
+          *  @pre Valid Memory Region Precondition: The range [begin, end) must be a valid range of memory to write to.
+          *  @param begin - The start of the char buffer
+          *  @param end - Just past the end of the char buffer
+          *  @return char* - Just past the end of the last character written (returns begin if the Appropriate Size Precondition is not satisfied)
+          *  @post If the Appropriate Size Precondition is satisfied, the range [begin, returned pointer) contains the string representation of the block_timestamp.
+          */
+         char* write_as_string( char* begin, char* end )const {
+            return to_time_point().write_as_string( begin, end );
+         }
+
+         /**
+          * Returns the time of the block slot as YYYY-MM-DDTHH:MM:SS.sss in UTC
+          */
+         std::string to_string()const {
+            return to_time_point().to_string();
+         }
+
+         /**
+          * Prints the time of the block slot as YYYY-MM-DDTHH:MM:SS.sss
+          */
+         void print()const {
+            to_time_point().print();
+         }
+
+         /**
+          * Renders the time of the block slot into a print_buffer as YYYY-MM-DDTHH:MM:SS.sss
+          *
+          * @param buf - The buffer to render into
+          */
+         void print( print_buffer& buf )const {
+            to_time_point().print( buf );
+         }
+
          EOSLIB_SERIALIZE( block_timestamp, (slot) )
       private:
 
@@ -207,4 +383,24 @@ namespace eosio {
     */
    typedef block_timestamp block_timestamp_type;
 
+   /// @cond IMPLEMENTATIONS
+
+   static_assert( sizeof(microseconds) == sizeof(int64_t), "microseconds must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<microseconds> : std::true_type {};
+
+   static_assert( sizeof(time_point) == sizeof(int64_t), "time_point must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<time_point> : std::true_type {};
+
+   static_assert( sizeof(time_point_sec) == sizeof(uint32_t), "time_point_sec must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<time_point_sec> : std::true_type {};
+
+   static_assert( sizeof(block_timestamp) == sizeof(uint32_t), "block_timestamp must be laid out as its serialized form" );
+   template<>
+   struct is_memcpy_serializable<block_timestamp> : std::true_type {};
+
+   /// @endcond
+
 } // namespace eosio
@@ -4,6 +4,11 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
 namespace eosio {
    /**
     * @defgroup varint Variable Length Integer Type
@@ -12,6 +17,111 @@ namespace eosio {
     * @brief Defines variable length integer type which provides more efficient serialization
     */
 
+   /**
+    * Codec behind unsigned_int and signed_int.
+    *
+    * A varuint32 is at most 5 bytes. Encoding builds all of them in a register and stores them after one bounds
+    * check, or hands them to streams without a position in one write. Decoding from a stream that exposes its
+    * position loads 5 bytes after one bounds check, finds the terminating byte from the continuation bits and
+    * gathers the 7 bit groups with shifts and masks. Single byte values, the common case for lengths, are
+    * handled first. Streams with fewer than 5 bytes left, or encodings longer than 5 bytes, take the byte at a
+    * time loop, which is kept out of line so the fast path stays small enough to inline.
+    */
+   namespace _varint_detail {
+      static constexpr size_t max_size = 5;
+
+      // continuation bits of the 5 bytes of a varuint32
+      static constexpr uint64_t continuation_bits = 0x8080808080ull;
+
+      /// encodes v into the low bytes of the result and sets n to the number of bytes used
+      inline uint64_t encode( uint32_t v, size_t& n ) {
+         const uint64_t x = v;
+         n = (32 - __builtin_clz( v | 1 ) + 6) / 7;
+         const uint64_t w = (x & 0x7f) | ((x << 1) & 0x7f00) | ((x << 2) & 0x7f0000) | ((x << 3) & 0x7f000000) | ((x << 4) & 0x7f00000000ull);
+         return w | (continuation_bits & ((uint64_t(1) << (8 * (n - 1))) - 1));
+      }
+
+      // streams over a plain buffer, which can be peeked at and written to directly after one bounds check
+      template<typename DataStream, typename = void>
+      struct has_position : std::false_type {};
+
+      template<typename DataStream>
+      struct has_position<DataStream, std::void_t<decltype(std::declval<const DataStream&>().pos()),
+                                                  decltype(std::declval<const DataStream&>().valid()),
+                                                  decltype(std::declval<const DataStream&>().remaining())>>
+         : std::is_pointer<decltype(std::declval<const DataStream&>().pos())> {};
+
+      template<typename DataStream>
+      void write( DataStream& ds, uint32_t v ) {
+         // most lengths fit in one byte
+         if ( v < 0x80 ) {
+            const char b = char(v);
+            ds.write( &b, 1 );
+            return;
+         }
+         size_t n;
+         const uint64_t w = encode( v, n );
+         if constexpr ( has_position<DataStream>::value ) {
+            // 2 to 5 bytes as two overlapping stores of the first and last bytes
+            if ( ds.valid() && ds.remaining() >= n ) {
+               char* out = (char*)ds.pos();
+               if ( n >= 4 ) {
+                  const uint32_t head = uint32_t(w), tail = uint32_t(w >> (8 * (n - 4)));
+                  memcpy( out, &head, 4 );
+                  memcpy( out + n - 4, &tail, 4 );
+               } else {
+                  const uint16_t head = uint16_t(w), tail = uint16_t(w >> (8 * (n - 2)));
+                  memcpy( out, &head, 2 );
+                  memcpy( out + n - 2, &tail, 2 );
+               }
+               ds.skip( n );
+               return;
+            }
+         }
+         char buf[sizeof(w)];
+         memcpy( buf, &w, sizeof(w) );
+         ds.write( buf, n );
+      }
+
+      template<typename DataStream>
+      __attribute__((noinline)) uint32_t read_bytewise( DataStream& ds ) {
+         uint64_t v = 0; char b = 0; uint8_t by = 0;
+         do {
+            ds.get(b);
+            if ( by < 32 )
+               v |= uint64_t(uint8_t(b) & 0x7f) << by;
+            by += 7;
+         } while( uint8_t(b) & 0x80 );
+         return static_cast<uint32_t>(v);
+      }
+
+      template<typename DataStream>
+      uint32_t read( DataStream& ds ) {
+         if constexpr ( has_position<DataStream>::value ) {
+            const size_t left = ds.valid() ? ds.remaining() : 0;
+            const char*  p    = ds.pos();
+            if ( left && !(uint8_t(p[0]) & 0x80) ) {
+               ds.skip( 1 );
+               return uint8_t(p[0]);
+            }
+            if ( left >= max_size ) {
+               uint32_t lo;
+               memcpy( &lo, p, sizeof(lo) );
+               uint64_t w = lo | uint64_t(uint8_t(p[4])) << 32;
+               const uint64_t last = ~w & continuation_bits;
+               if ( last ) {
+                  const size_t n = (__builtin_ctzll( last ) >> 3) + 1;
+                  w &= (uint64_t(1) << (8 * n)) - 1;
+                  ds.skip( n );
+                  return static_cast<uint32_t>( (w & 0x7f) | ((w >> 1) & 0x3f80) | ((w >> 2) & 0x1fc000) |
+                                                ((w >> 3) & 0xfe00000) | ((w >> 4) & 0x7f0000000ull) );
+               }
+            }
+         }
+         return read_bytewise( ds );
+      }
+   }
+
    /**
     *  Variable Length Unsigned Integer. This provides more efficient serialization of 32-bit unsigned int.
     *  It serialuzes a 32-bit unsigned integer in as few bytes as possible
@@ -203,13 +313,7 @@ namespace eosio {
         */
        template<typename DataStream>
        friend DataStream& operator << ( DataStream& ds, const unsigned_int& v ){
-          uint64_t val = v.value;
-          do {
-             uint8_t b = uint8_t(val) & 0x7f;
-             val >>= 7;
-             b |= ((val > 0) << 7);
-             ds.write((char*)&b,1);//.put(b);
-          } while( val );
+          _varint_detail::write( ds, v.value );
           return ds;
        }
 
@@ -223,13 +327,7 @@ namespace eosio {
         */
        template<typename DataStream>
        friend DataStream& operator >> ( DataStream& ds, unsigned_int& vi ){
-         uint64_t v = 0; char b = 0; uint8_t by = 0;
-         do {
-            ds.get(b);
-            v |= uint32_t(uint8_t(b) & 0x7f) << by;
-            by += 7;
-         } while( uint8_t(b) & 0x80 );
-         vi.value = static_cast<uint32_t>(v);
+         vi.value = _varint_detail::read( ds );
          return ds;
        }
 
@@ -430,14 +528,8 @@ namespace eosio {
         */
        template<typename DataStream>
        friend DataStream& operator << ( DataStream& ds, const signed_int& v ){
-         uint32_t val = uint32_t((v.value<<1) ^ (v.value>>31));
-         do {
-            uint8_t b = uint8_t(val) & 0x7f;
-            val >>= 7;
-            b |= ((val > 0) << 7);
-            ds.write((char*)&b,1);//.put(b);
-         } while( val );
-          return ds;
+         _varint_detail::write( ds, uint32_t((v.value<<1) ^ (v.value>>31)) );
+         return ds;
        }
 
        /**
@@ -450,12 +542,7 @@ namespace eosio {
         */
        template<typename DataStream>
        friend DataStream& operator >> ( DataStream& ds, signed_int& vi ){
-         uint32_t v = 0; char b = 0; int by = 0;
-         do {
-            ds.get(b);
-            v |= uint32_t(uint8_t(b) & 0x7f) << by;
-            by += 7;
-         } while( uint8_t(b) & 0x80 );
+         const uint32_t v = _varint_detail::read( ds );
          vi.value = (v>>1) ^ (~(v&1)+1ull);
          return ds;
        }
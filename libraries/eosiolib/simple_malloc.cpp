@@ -46,7 +46,8 @@ namespace eosio {
             next_page++;
             pages_to_alloc++;
          }         
-         eosio::check(GROW_MEMORY(pages_to_alloc) != -1, "failed to allocate pages");  
+         if (pages_to_alloc)
+            eosio::check(GROW_MEMORY(pages_to_alloc) != -1, "failed to allocate pages");
          return ret;
       }
 
@@ -0,0 +1,212 @@
+#include <memory>
+#include "core/eosio/check.hpp"
+
+#ifdef EOSIO_NATIVE
+   extern "C" {
+      size_t _current_memory();
+      size_t _grow_memory(size_t);
+      void* __get_heap_base();
+   }
+#define CURRENT_MEMORY _current_memory()
+#define GROW_MEMORY(X) _grow_memory(X)
+#else
+#define CURRENT_MEMORY __builtin_wasm_current_memory()
+#define GROW_MEMORY(X) __builtin_wasm_grow_memory(X)
+#endif
+
+extern "C" void* memset(void*,int,size_t);
+extern "C" void* memcpy(void*,const void*,size_t);
+
+namespace eosio {
+   /**
+    * Segregated size class allocator.
+    *
+    * Requests up to 256 bytes are rounded to a multiple of 16, larger ones up to 1MiB to a power of two.
+    * Every class keeps an intrusive singly linked free list, so malloc and free are constant time and freed
+    * blocks are reused by later requests of the same class. Requests larger than the biggest class are
+    * served exactly and recycled through a first fit list.
+    *
+    * Blocks are carved from a bump region that grows by whole wasm pages, with a single GROW_MEMORY call
+    * for all the pages a request needs. The block at the top of the region can be grown or released in place.
+    */
+   struct scmalloc {
+      static constexpr uint32_t wasm_page_size = 64*1024;
+      static constexpr size_t   alignment      = 8;
+      static constexpr size_t   header_size    = 8;
+      static constexpr size_t   small_step     = 16;
+      static constexpr size_t   small_limit    = 256;
+      static constexpr size_t   num_small      = small_limit / small_step;
+      static constexpr size_t   first_large_l2 = 9;  // 512 bytes
+      static constexpr size_t   last_large_l2  = 20; // 1MiB
+      static constexpr size_t   num_classes    = num_small + last_large_l2 - first_large_l2 + 1;
+      static constexpr uint32_t huge_class     = 0xFFFFFFFF;
+
+      struct header {
+         uint32_t capacity;
+         uint32_t size_class;
+      };
+      static_assert( sizeof(header) == header_size, "unexpected block header size" );
+
+      static header* header_of( char* ptr ) { return reinterpret_cast<header*>(ptr - header_size); }
+      static char*&  next_of( char* ptr ) { return *reinterpret_cast<char**>(ptr); }
+
+      static inline size_t align( size_t v, size_t align_amt ) {
+         return (v + align_amt-1) & ~(align_amt-1);
+      }
+
+      static uint32_t class_of( size_t sz ) {
+         if ( sz <= small_limit )
+            return (sz + small_step - 1) / small_step - 1;
+         size_t l2 = 64 - __builtin_clzll( uint64_t(sz - 1) );
+         if ( l2 > last_large_l2 )
+            return huge_class;
+         return num_small + l2 - first_large_l2;
+      }
+
+      static size_t capacity_of( uint32_t c ) {
+         if ( c < num_small )
+            return (c + 1) * small_step;
+         return size_t(1) << (c - num_small + first_large_l2);
+      }
+
+      void init() {
+#ifdef EOSIO_NATIVE
+         size_t memory_base = (size_t)__get_heap_base();
+         top = (char*)align( memory_base, alignment );
+#else
+         size_t memory_base = 0;
+         volatile uintptr_t heap_base = 0; // linker places this at address 0
+         top = (char*)align( (size_t)*(char**)heap_base, alignment );
+#endif
+         end = (char*)(memory_base + size_t(CURRENT_MEMORY) * wasm_page_size);
+      }
+
+      /// carves a block of the given capacity from the top of the region, growing memory if needed
+      char* carve( size_t capacity, uint32_t size_class ) {
+         if ( top == nullptr )
+            init();
+
+         const size_t needed = header_size + capacity;
+         if ( size_t(end - top) < needed )
+            grow( needed - size_t(end - top) );
+
+         char* ptr = top + header_size;
+         top += needed;
+         header_of(ptr)->capacity   = capacity;
+         header_of(ptr)->size_class = size_class;
+         return ptr;
+      }
+
+      void grow( size_t bytes ) {
+         const size_t pages = (bytes + wasm_page_size - 1) / wasm_page_size;
+         eosio::check( GROW_MEMORY(pages) != -1, "failed to allocate pages" );
+         end += pages * wasm_page_size;
+      }
+
+      bool is_top( char* ptr ) {
+         return ptr + header_of(ptr)->capacity == top;
+      }
+
+      char* allocate( size_t sz ) {
+         if ( sz == 0 )
+            return nullptr;
+
+         const uint32_t c = class_of( sz );
+         if ( c != huge_class ) {
+            if ( char* ptr = free_lists[c] ) {
+               free_lists[c] = next_of(ptr);
+               return ptr;
+            }
+            return carve( capacity_of(c), c );
+         }
+
+         for ( char** link = &huge_list; *link; link = &next_of(*link) ) {
+            char* ptr = *link;
+            if ( header_of(ptr)->capacity >= sz ) {
+               *link = next_of(ptr);
+               return ptr;
+            }
+         }
+         return carve( align(sz, alignment), huge_class );
+      }
+
+      void release( char* ptr ) {
+         if ( ptr == nullptr )
+            return;
+
+         // the top block goes straight back to the bump region
+         if ( is_top(ptr) ) {
+            top = ptr - header_size;
+            return;
+         }
+
+         const uint32_t c = header_of(ptr)->size_class;
+         char*& list = c == huge_class ? huge_list : free_lists[c];
+         next_of(ptr) = list;
+         list = ptr;
+      }
+
+      char* reallocate( char* ptr, size_t sz ) {
+         if ( ptr == nullptr )
+            return allocate( sz );
+         if ( sz == 0 ) {
+            release( ptr );
+            return nullptr;
+         }
+
+         header* h = header_of(ptr);
+         if ( sz <= h->capacity )
+            return ptr;
+
+         // grow the top block in place, it takes the capacity of its new class
+         if ( is_top(ptr) ) {
+            const uint32_t c        = class_of( sz );
+            const size_t   capacity = c == huge_class ? align(sz, alignment) : capacity_of(c);
+            const size_t   extra    = capacity - h->capacity;
+            if ( size_t(end - top) < extra )
+               grow( extra - size_t(end - top) );
+            top += extra;
+            h->capacity   = capacity;
+            h->size_class = c;
+            return ptr;
+         }
+
+         char* new_ptr = allocate( sz );
+         memcpy( new_ptr, ptr, h->capacity );
+         release( ptr );
+         return new_ptr;
+      }
+
+      char* top;
+      char* end;
+      char* huge_list;
+      char* free_lists[num_classes];
+   };
+   // zero initialized, initialization happens on the first allocation
+   scmalloc _scmalloc;
+} // ns eosio
+
+extern "C" {
+
+void* malloc(size_t size) {
+   return eosio::_scmalloc.allocate(size);
+}
+
+void* calloc(size_t count, size_t size) {
+   if (size != 0 && count > size_t(-1) / size)
+      return nullptr;
+   if (void* ptr = eosio::_scmalloc.allocate(count*size)) {
+      memset(ptr, 0, count*size);
+      return ptr;
+   }
+   return nullptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+   return eosio::_scmalloc.reallocate((char*)ptr, size);
+}
+
+void free(void* ptr) {
+   eosio::_scmalloc.release((char*)ptr);
+}
+}
@@ -2,6 +2,7 @@
 #include <eosio/action.hpp>
 #include "native/eosio/intrinsics.hpp"
 #include "native/eosio/crt.hpp"
+#include "native/eosio/memory_db.hpp"
 #include <cstdint>
 #include <functional>
 #include <stdio.h>
@@ -23,7 +24,9 @@ extern "C" {
    char* ___heap_base_ptr;
    size_t ___pages;
    void ___putc(char c);
+   long ___write(const char* cstr, size_t len);
    bool ___disable_output;
+   bool ___quiet_output;
    bool ___has_failed;
    
    void* __get_heap_base() {
@@ -41,26 +44,35 @@ extern "C" {
       return ++___pages;
    }
 
-   void _prints_l(const char* cstr, uint32_t len, uint8_t which) {
-      for (int i=0; i < len; i++) {
-         if (which == eosio::cdt::output_stream_kind::std_out)
-            std_out.push(cstr[i]);
-         else if (which == eosio::cdt::output_stream_kind::std_err)
-            std_err.push(cstr[i]);
-         if (!___disable_output)
-            ___putc(cstr[i]);
+   // writes to stdout in as few syscalls as it takes, instead of one per character
+   static void write_stdout(const char* cstr, size_t len) {
+      while (len > 0) {
+         const long written = ___write(cstr, len);
+         if (written == -4) // EINTR
+            continue;
+         if (written <= 0)
+            return;
+         cstr += written;
+         len  -= written;
       }
    }
 
+   // quiet output drops everything but the assert messages, which are still captured in std_err
+   void _prints_l(const char* cstr, uint32_t len, uint8_t which) {
+      if (which == eosio::cdt::output_stream_kind::std_err)
+         std_err.append(cstr, len);
+      else if (___quiet_output)
+         return;
+      else if (which == eosio::cdt::output_stream_kind::std_out)
+         std_out.append(cstr, len);
+      if (!___disable_output && !___quiet_output)
+         write_stdout(cstr, len);
+   }
+
    void _prints(const char* cstr, uint8_t which) {
-      for (int i=0; cstr[i] != '\0'; i++) {
-         if (which == eosio::cdt::output_stream_kind::std_out)
-            std_out.push(cstr[i]);
-         else if (which == eosio::cdt::output_stream_kind::std_err)
-            std_err.push(cstr[i]);
-         if (!___disable_output)
-            ___putc(cstr[i]);
-      }
+      if (___quiet_output && which != eosio::cdt::output_stream_kind::std_err)
+         return;
+      _prints_l(cstr, strlen(cstr), which);
    }
 
    void __set_env_test() {
@@ -78,6 +90,7 @@ extern "C" {
       ___heap_base_ptr = ___heap;
       ___pages = 1;
       ___disable_output = false;
+      ___quiet_output = false;
       ___has_failed = false;
       // preset the print functions
       intrinsics::set_intrinsic<intrinsics::prints_l>([](const char* cs, uint32_t l) {
@@ -87,20 +100,30 @@ extern "C" {
             _prints(cs, eosio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printi>([](int64_t v) {
+            if (___quiet_output)
+               return;
             printf("%lli", v);
          });
       intrinsics::set_intrinsic<intrinsics::printui>([](uint64_t v) {
+            if (___quiet_output)
+               return;
             printf("%llu", v);
          });
       intrinsics::set_intrinsic<intrinsics::printi128>([](const int128_t* v) {
+            if (___quiet_output)
+               return;
             int* tmp = (int*)v;
             printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
          });
       intrinsics::set_intrinsic<intrinsics::printui128>([](const uint128_t* v) {
+            if (___quiet_output)
+               return;
             int* tmp = (int*)v;
             printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
          });
       intrinsics::set_intrinsic<intrinsics::printsf>([](float v) {
+            if (___quiet_output)
+               return;
             char buff[512] = {0};
             std::string ret = std::to_string((int)v);
             memcpy(buff, ret.c_str(), ret.size());
@@ -115,6 +138,8 @@ extern "C" {
             prints(buff);
          });
       intrinsics::set_intrinsic<intrinsics::printdf>([](double v) {
+            if (___quiet_output)
+               return;
             char buff[512] = {0};
             std::string ret = std::to_string((long)v);
             memcpy(buff, ret.c_str(), ret.size());
@@ -129,13 +154,19 @@ extern "C" {
             prints(buff);
          });
       intrinsics::set_intrinsic<intrinsics::printqf>([](const long double* v) {
+            if (___quiet_output)
+               return;
             int* tmp = (int*)v;
             printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
          });
       intrinsics::set_intrinsic<intrinsics::printn>([](uint64_t nm) {
+            if (___quiet_output)
+               return;
             std::string s = eosio::name(nm).to_string();
             prints_l(s.c_str(), s.length());
          });
+      // back the db_* intrinsics with in-memory tables
+      memory_db::install();
 
       jmp_ret = setjmp(env); 
       if (jmp_ret == 0) {
@@ -1,11 +1,15 @@
 .global _start
 .global ___putc
+.global ___write
 .global _mmap
+.global ___clock_ns
 .global setjmp
 .global longjmp
 .type _start,@function
 .type ___putc,@function
+.type ___write,@function
 .type _mmap,@function
+.type ___clock_ns,@function
 .type setjmp,@function
 .type longjmp,@function
 
@@ -31,6 +35,14 @@ ___putc:
    inc %rsp
    mov %r8, %rbx
    ret
+
+___write:
+   mov %rsi, %rdx  # length
+   mov %rdi, %rsi  # buffer
+   mov $1, %edi    # stdout
+   mov $1, %eax    # write syscall
+   syscall
+   ret
   
 _mmap:
    mov $9, %eax
@@ -43,6 +55,18 @@ _mmap:
    syscall
    ret 
 
+___clock_ns:
+   sub $16, %rsp
+   mov $228, %eax   # clock_gettime syscall
+   mov $1, %edi     # CLOCK_MONOTONIC
+   mov %rsp, %rsi   # timespec on the stack
+   syscall
+   mov 0(%rsp), %rax
+   imul $1000000000, %rax
+   add 8(%rsp), %rax
+   add $16, %rsp
+   ret
+
 setjmp:
 	mov %rbx, 0(%rdi)
 	mov %rbp, 8(%rdi)
@@ -17,319 +17,319 @@
 using namespace eosio::native;
 extern "C" {
    void get_resource_limits( capi_name account, int64_t* ram_bytes, int64_t* net_weight, int64_t* cpu_weight ) {
-      return intrinsics::get().call<intrinsics::get_resource_limits>(account, ram_bytes, net_weight, cpu_weight);
+      return intrinsics::call<intrinsics::get_resource_limits>(account, ram_bytes, net_weight, cpu_weight);
    }
    void set_resource_limits( capi_name account, int64_t ram_bytes, int64_t net_weight, int64_t cpu_weight ) {
-      return intrinsics::get().call<intrinsics::set_resource_limits>(account, ram_bytes, net_weight, cpu_weight);
+      return intrinsics::call<intrinsics::set_resource_limits>(account, ram_bytes, net_weight, cpu_weight);
    }
    int64_t set_proposed_producers( char *producer_data, uint32_t producer_data_size ) {
-      return intrinsics::get().call<intrinsics::set_proposed_producers>(producer_data, producer_data_size);
+      return intrinsics::call<intrinsics::set_proposed_producers>(producer_data, producer_data_size);
    }
    uint32_t get_blockchain_parameters_packed( char* data, uint32_t datalen ) {
-      return intrinsics::get().call<intrinsics::get_blockchain_parameters_packed>(data, datalen);
+      return intrinsics::call<intrinsics::get_blockchain_parameters_packed>(data, datalen);
    }
    void set_blockchain_parameters_packed( char* data, uint32_t datalen ) {
-      return intrinsics::get().call<intrinsics::set_blockchain_parameters_packed>(data, datalen);
+      return intrinsics::call<intrinsics::set_blockchain_parameters_packed>(data, datalen);
    }
    bool is_privileged( capi_name account ) {
-      return intrinsics::get().call<intrinsics::is_privileged>(account);
+      return intrinsics::call<intrinsics::is_privileged>(account);
    }
    void set_privileged( capi_name account, bool is_priv ) {
-      return intrinsics::get().call<intrinsics::set_privileged>(account, is_priv);
+      return intrinsics::call<intrinsics::set_privileged>(account, is_priv);
    }
    uint32_t get_active_producers( capi_name* producers, uint32_t datalen ) {
-      return intrinsics::get().call<intrinsics::get_active_producers>(producers, datalen);
+      return intrinsics::call<intrinsics::get_active_producers>(producers, datalen);
    }
    int32_t db_idx64_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint64_t* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx64_store>(scope, table, payer, id, secondary);
+      return intrinsics::call<intrinsics::db_idx64_store>(scope, table, payer, id, secondary);
    }
    void db_idx64_remove(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_idx64_remove>(iterator);
+      return intrinsics::call<intrinsics::db_idx64_remove>(iterator);
    }
    void db_idx64_update(int32_t iterator, capi_name payer, const uint64_t* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx64_update>(iterator, payer, secondary);
+      return intrinsics::call<intrinsics::db_idx64_update>(iterator, payer, secondary);
    }
    int32_t db_idx64_find_primary(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary, uint64_t primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_find_primary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx64_find_primary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx64_find_secondary(capi_name code, uint64_t scope, capi_name table, const uint64_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_find_secondary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx64_find_secondary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx64_lowerbound(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_lowerbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx64_lowerbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx64_upperbound(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_upperbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx64_upperbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx64_end(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_idx64_end>(code, scope, table);
+      return intrinsics::call<intrinsics::db_idx64_end>(code, scope, table);
    }
    int32_t db_idx64_next(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_next>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx64_next>(iterator, primary);
    }
    int32_t db_idx64_previous(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx64_previous>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx64_previous>(iterator, primary);
    }
    int32_t db_idx128_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint128_t* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx128_store>(scope, table, payer, id, secondary);
+      return intrinsics::call<intrinsics::db_idx128_store>(scope, table, payer, id, secondary);
    }
    void db_idx128_remove(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_idx128_remove>(iterator);
+      return intrinsics::call<intrinsics::db_idx128_remove>(iterator);
    }
    void db_idx128_update(int32_t iterator, capi_name payer, const uint128_t* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx128_update>(iterator, payer, secondary);
+      return intrinsics::call<intrinsics::db_idx128_update>(iterator, payer, secondary);
    }
    int32_t db_idx128_find_primary(capi_name code, uint64_t scope, capi_name table, uint128_t* secondary, uint64_t primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_find_primary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx128_find_primary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx128_find_secondary(capi_name code, uint64_t scope, capi_name table, const uint128_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_find_secondary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx128_find_secondary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx128_lowerbound(capi_name code, uint64_t scope, capi_name table, uint128_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_lowerbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx128_lowerbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx128_upperbound(capi_name code, uint64_t scope, capi_name table, uint128_t* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_upperbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx128_upperbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx128_end(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_idx128_end>(code, scope, table);
+      return intrinsics::call<intrinsics::db_idx128_end>(code, scope, table);
    }
    int32_t db_idx128_next(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_next>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx128_next>(iterator, primary);
    }
    int32_t db_idx128_previous(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx128_previous>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx128_previous>(iterator, primary);
    }
    int32_t db_idx256_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint128_t* data, uint32_t datalen) {
-      return intrinsics::get().call<intrinsics::db_idx256_store>(scope, table, payer, id, data, datalen);
+      return intrinsics::call<intrinsics::db_idx256_store>(scope, table, payer, id, data, datalen);
    }
    void db_idx256_remove(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_idx256_remove>(iterator);
+      return intrinsics::call<intrinsics::db_idx256_remove>(iterator);
    }
    void db_idx256_update(int32_t iterator, capi_name payer, const uint128_t* data, uint32_t datalen) {
-      return intrinsics::get().call<intrinsics::db_idx256_update>(iterator, payer, data, datalen);
+      return intrinsics::call<intrinsics::db_idx256_update>(iterator, payer, data, datalen);
    }
    int32_t db_idx256_find_primary(capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen,  uint64_t primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_find_primary>(code, scope, table, data, datalen, primary);
+      return intrinsics::call<intrinsics::db_idx256_find_primary>(code, scope, table, data, datalen, primary);
    }
    int32_t db_idx256_find_secondary(capi_name code, uint64_t scope, capi_name table, const uint128_t* data, uint32_t datalen, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_find_secondary>(code, scope, table, data, datalen, primary);
+      return intrinsics::call<intrinsics::db_idx256_find_secondary>(code, scope, table, data, datalen, primary);
    }
    int32_t db_idx256_lowerbound(capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_lowerbound>(code, scope, table, data, datalen, primary);
+      return intrinsics::call<intrinsics::db_idx256_lowerbound>(code, scope, table, data, datalen, primary);
    }
    int32_t db_idx256_upperbound(capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen,  uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_upperbound>(code, scope, table, data, datalen, primary);
+      return intrinsics::call<intrinsics::db_idx256_upperbound>(code, scope, table, data, datalen, primary);
    }
    int32_t db_idx256_end(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_idx256_end>(code, scope, table);
+      return intrinsics::call<intrinsics::db_idx256_end>(code, scope, table);
    }
    int32_t db_idx256_next(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_next>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx256_next>(iterator, primary);
    }
    int32_t db_idx256_previous(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx256_previous>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx256_previous>(iterator, primary);
    }
    int32_t db_idx_double_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const double* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_store>(scope, table, payer, id, secondary);
+      return intrinsics::call<intrinsics::db_idx_double_store>(scope, table, payer, id, secondary);
    }
    void db_idx_double_remove(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_idx_double_remove>(iterator);
+      return intrinsics::call<intrinsics::db_idx_double_remove>(iterator);
    }
    void db_idx_double_update(int32_t iterator, capi_name payer, const double* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_update>(iterator, payer, secondary);
+      return intrinsics::call<intrinsics::db_idx_double_update>(iterator, payer, secondary);
    }
    int32_t db_idx_double_find_primary(capi_name code, uint64_t scope, capi_name table, double* secondary, uint64_t primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_find_primary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_double_find_primary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_double_find_secondary(capi_name code, uint64_t scope, capi_name table, const double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_find_secondary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_double_find_secondary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_double_lowerbound(capi_name code, uint64_t scope, capi_name table, double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_lowerbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_double_lowerbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_double_upperbound(capi_name code, uint64_t scope, capi_name table, double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_upperbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_double_upperbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_double_end(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_idx_double_end>(code, scope, table);
+      return intrinsics::call<intrinsics::db_idx_double_end>(code, scope, table);
    }
    int32_t db_idx_double_next(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_next>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx_double_next>(iterator, primary);
    }
    int32_t db_idx_double_previous(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_double_previous>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx_double_previous>(iterator, primary);
    }
    int32_t db_idx_long_double_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const long double* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_store>(scope, table, payer, id, secondary);
+      return intrinsics::call<intrinsics::db_idx_long_double_store>(scope, table, payer, id, secondary);
    }
    void db_idx_long_double_remove(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_remove>(iterator);
+      return intrinsics::call<intrinsics::db_idx_long_double_remove>(iterator);
    }
    void db_idx_long_double_update(int32_t iterator, capi_name payer, const long double* secondary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_update>(iterator, payer, secondary);
+      return intrinsics::call<intrinsics::db_idx_long_double_update>(iterator, payer, secondary);
    }
    int32_t db_idx_long_double_find_primary(capi_name code, uint64_t scope, capi_name table, long double* secondary, uint64_t primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_find_primary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_find_primary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_long_double_find_secondary(capi_name code, uint64_t scope, capi_name table, const long double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_find_secondary>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_find_secondary>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_long_double_lowerbound(capi_name code, uint64_t scope, capi_name table, long double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_lowerbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_lowerbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_long_double_upperbound(capi_name code, uint64_t scope, capi_name table, long double* secondary, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_upperbound>(code, scope, table, secondary, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_upperbound>(code, scope, table, secondary, primary);
    }
    int32_t db_idx_long_double_end(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_end>(code, scope, table);
+      return intrinsics::call<intrinsics::db_idx_long_double_end>(code, scope, table);
    }
    int32_t db_idx_long_double_next(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_next>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_next>(iterator, primary);
    }
    int32_t db_idx_long_double_previous(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_idx_long_double_previous>(iterator, primary);
+      return intrinsics::call<intrinsics::db_idx_long_double_previous>(iterator, primary);
    }
    int32_t db_store_i64(uint64_t scope, capi_name table, capi_name payer, uint64_t id,  const void* data, uint32_t len) {
-      return intrinsics::get().call<intrinsics::db_store_i64>(scope, table, payer, id, data, len);
+      return intrinsics::call<intrinsics::db_store_i64>(scope, table, payer, id, data, len);
    }
    void db_update_i64(int32_t iterator, capi_name payer, const void* data, uint32_t len) {
-      return intrinsics::get().call<intrinsics::db_update_i64>(iterator, payer, data, len);
+      return intrinsics::call<intrinsics::db_update_i64>(iterator, payer, data, len);
    }
    void db_remove_i64(int32_t iterator) {
-      return intrinsics::get().call<intrinsics::db_remove_i64>(iterator);
+      return intrinsics::call<intrinsics::db_remove_i64>(iterator);
    }
    int32_t db_get_i64(int32_t iterator, const void* data, uint32_t len) {
-      return intrinsics::get().call<intrinsics::db_get_i64>(iterator, data, len);
+      return intrinsics::call<intrinsics::db_get_i64>(iterator, data, len);
    }
    int32_t db_next_i64(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_next_i64>(iterator, primary);
+      return intrinsics::call<intrinsics::db_next_i64>(iterator, primary);
    }
    int32_t db_previous_i64(int32_t iterator, uint64_t* primary) {
-      return intrinsics::get().call<intrinsics::db_previous_i64>(iterator, primary);
+      return intrinsics::call<intrinsics::db_previous_i64>(iterator, primary);
    }
    int32_t db_find_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
-      return intrinsics::get().call<intrinsics::db_find_i64>(code, scope, table, id);
+      return intrinsics::call<intrinsics::db_find_i64>(code, scope, table, id);
    }
    int32_t db_lowerbound_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
-      return intrinsics::get().call<intrinsics::db_lowerbound_i64>(code, scope, table, id);
+      return intrinsics::call<intrinsics::db_lowerbound_i64>(code, scope, table, id);
    }
    int32_t db_upperbound_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
-      return intrinsics::get().call<intrinsics::db_upperbound_i64>(code, scope, table, id);
+      return intrinsics::call<intrinsics::db_upperbound_i64>(code, scope, table, id);
    }
    int32_t db_end_i64(capi_name code, uint64_t scope, capi_name table) {
-      return intrinsics::get().call<intrinsics::db_end_i64>(code, scope, table);
+      return intrinsics::call<intrinsics::db_end_i64>(code, scope, table);
    }
    void assert_recover_key( const capi_checksum256* digest, const char* sig, size_t siglen, const char* pub, size_t publen ) {
-      return intrinsics::get().call<intrinsics::assert_recover_key>(digest, sig, siglen, pub, publen);
+      return intrinsics::call<intrinsics::assert_recover_key>(digest, sig, siglen, pub, publen);
    }
    int recover_key( const capi_checksum256* digest, const char* sig, size_t siglen, char* pub, size_t publen ) {
-      return intrinsics::get().call<intrinsics::recover_key>(digest, sig, siglen, pub, publen);
+      return intrinsics::call<intrinsics::recover_key>(digest, sig, siglen, pub, publen);
    }
    void assert_sha256( const char* data, uint32_t length, const capi_checksum256* hash ) {
-      return intrinsics::get().call<intrinsics::assert_sha256>(data, length, hash);
+      return intrinsics::call<intrinsics::assert_sha256>(data, length, hash);
    }
    void assert_sha1( const char* data, uint32_t length, const capi_checksum160* hash ) {
-      return intrinsics::get().call<intrinsics::assert_sha1>(data, length, hash);
+      return intrinsics::call<intrinsics::assert_sha1>(data, length, hash);
    }
    void assert_sha512( const char* data, uint32_t length, const capi_checksum512* hash ) {
-      return intrinsics::get().call<intrinsics::assert_sha512>(data, length, hash);
+      return intrinsics::call<intrinsics::assert_sha512>(data, length, hash);
    }
    void assert_ripemd160( const char* data, uint32_t length, const capi_checksum160* hash ) {
-      return intrinsics::get().call<intrinsics::assert_ripemd160>(data, length, hash);
+      return intrinsics::call<intrinsics::assert_ripemd160>(data, length, hash);
    }
    void sha256( const char* data, uint32_t length, capi_checksum256* hash ) {
-      return intrinsics::get().call<intrinsics::sha256>(data, length, hash);
+      return intrinsics::call<intrinsics::sha256>(data, length, hash);
    }
    void sha1( const char* data, uint32_t length, capi_checksum160* hash ) {
-      return intrinsics::get().call<intrinsics::sha1>(data, length, hash);
+      return intrinsics::call<intrinsics::sha1>(data, length, hash);
    }
    void sha512( const char* data, uint32_t length, capi_checksum512* hash ) {
-      return intrinsics::get().call<intrinsics::sha512>(data, length, hash);
+      return intrinsics::call<intrinsics::sha512>(data, length, hash);
    }
    void ripemd160( const char* data, uint32_t length, capi_checksum160* hash ) {
-      return intrinsics::get().call<intrinsics::ripemd160>(data, length, hash);
+      return intrinsics::call<intrinsics::ripemd160>(data, length, hash);
    }
    int32_t check_transaction_authorization( const char* trx_data,     uint32_t trx_size,
                                     const char* pubkeys_data, uint32_t pubkeys_size,
                                     const char* perms_data,   uint32_t perms_size
                                   ) {
-      return intrinsics::get().call<intrinsics::check_transaction_authorization>(trx_data, trx_size, pubkeys_data, pubkeys_size, perms_data, perms_size);
+      return intrinsics::call<intrinsics::check_transaction_authorization>(trx_data, trx_size, pubkeys_data, pubkeys_size, perms_data, perms_size);
    }
    int32_t check_permission_authorization( capi_name account, capi_name permission,
                                     const char* pubkeys_data, uint32_t pubkeys_size,
                                     const char* perms_data,   uint32_t perms_size, uint64_t delay_us
                                   ) {
-      return intrinsics::get().call<intrinsics::check_permission_authorization>(account, permission, pubkeys_data, pubkeys_size, perms_data, perms_size, delay_us);
+      return intrinsics::call<intrinsics::check_permission_authorization>(account, permission, pubkeys_data, pubkeys_size, perms_data, perms_size, delay_us);
    }
    int64_t get_permission_last_used( capi_name account, capi_name permission ) {
-      return intrinsics::get().call<intrinsics::get_permission_last_used>(account, permission);
+      return intrinsics::call<intrinsics::get_permission_last_used>(account, permission);
    }
    int64_t get_account_creation_time( capi_name account ) {
-      return intrinsics::get().call<intrinsics::get_account_creation_time>(account);
+      return intrinsics::call<intrinsics::get_account_creation_time>(account);
    }
    uint64_t  current_time() {
-      return intrinsics::get().call<intrinsics::current_time>();
+      return intrinsics::call<intrinsics::current_time>();
    }
    uint64_t  publication_time() {
-      return intrinsics::get().call<intrinsics::publication_time>();
+      return intrinsics::call<intrinsics::publication_time>();
    }
    uint32_t read_action_data( void* msg, uint32_t len ) {
-      return intrinsics::get().call<intrinsics::read_action_data>(msg, len);
+      return intrinsics::call<intrinsics::read_action_data>(msg, len);
    }
    uint32_t action_data_size() {
-      return intrinsics::get().call<intrinsics::action_data_size>();
+      return intrinsics::call<intrinsics::action_data_size>();
    }
    capi_name current_receiver() {
-      return intrinsics::get().call<intrinsics::current_receiver>();
+      return intrinsics::call<intrinsics::current_receiver>();
    }
    void require_recipient( capi_name name ) {
-      return intrinsics::get().call<intrinsics::require_recipient>(name);
+      return intrinsics::call<intrinsics::require_recipient>(name);
    }
    void require_auth( capi_name name ) {
-      return intrinsics::get().call<intrinsics::require_auth>(name);
+      return intrinsics::call<intrinsics::require_auth>(name);
    }
    void require_auth2( capi_name name, capi_name permission ) {
-      return intrinsics::get().call<intrinsics::require_auth2>(name, permission);
+      return intrinsics::call<intrinsics::require_auth2>(name, permission);
    }
    bool has_auth( capi_name name ) {
-      return intrinsics::get().call<intrinsics::has_auth>(name);
+      return intrinsics::call<intrinsics::has_auth>(name);
    }
    bool is_account( capi_name name ) {
-      return intrinsics::get().call<intrinsics::is_account>(name);
+      return intrinsics::call<intrinsics::is_account>(name);
    }
    size_t read_transaction(char *buffer, size_t size) {
-      return intrinsics::get().call<intrinsics::read_transaction>(buffer, size);
+      return intrinsics::call<intrinsics::read_transaction>(buffer, size);
    }
    size_t transaction_size() {
-      return intrinsics::get().call<intrinsics::transaction_size>();
+      return intrinsics::call<intrinsics::transaction_size>();
    }
    uint32_t expiration() {
-      return intrinsics::get().call<intrinsics::expiration>();
+      return intrinsics::call<intrinsics::expiration>();
    }
    int tapos_block_prefix() {
-      return intrinsics::get().call<intrinsics::tapos_block_prefix>();
+      return intrinsics::call<intrinsics::tapos_block_prefix>();
    }
    int tapos_block_num() {
-      return intrinsics::get().call<intrinsics::tapos_block_num>();
+      return intrinsics::call<intrinsics::tapos_block_num>();
    }
    int get_action( uint32_t type, uint32_t index, char* buff, size_t size ) {
-      return intrinsics::get().call<intrinsics::get_action>(type, index, buff, size);
+      return intrinsics::call<intrinsics::get_action>(type, index, buff, size);
    }
    void send_inline(char *serialized_action, size_t size) {
-      return intrinsics::get().call<intrinsics::send_inline>(serialized_action, size);
+      return intrinsics::call<intrinsics::send_inline>(serialized_action, size);
    }
    void send_context_free_inline(char *serialized_action, size_t size) {
-      return intrinsics::get().call<intrinsics::send_context_free_inline>(serialized_action, size);
+      return intrinsics::call<intrinsics::send_context_free_inline>(serialized_action, size);
    }
    void send_deferred(const uint128_t& sender_id, capi_name payer, const char *serialized_transaction, size_t size, uint32_t replace_existing) {
-      return intrinsics::get().call<intrinsics::send_deferred>(sender_id, payer, serialized_transaction, size, replace_existing);
+      return intrinsics::call<intrinsics::send_deferred>(sender_id, payer, serialized_transaction, size, replace_existing);
    }
    int cancel_deferred(const uint128_t& sender_id) {
-      return intrinsics::get().call<intrinsics::cancel_deferred>(sender_id);
+      return intrinsics::call<intrinsics::cancel_deferred>(sender_id);
    }
    int get_context_free_data( uint32_t index, char* buff, size_t size ) {
-      return intrinsics::get().call<intrinsics::get_context_free_data>(index, buff, size);
+      return intrinsics::call<intrinsics::get_context_free_data>(index, buff, size);
    }
 
    // softfloat
@@ -771,47 +771,47 @@ extern "C" {
    }
 
    void prints_l(const char* cstr, uint32_t len) {
-      return intrinsics::get().call<intrinsics::prints_l>(cstr, len);
+      return intrinsics::call<intrinsics::prints_l>(cstr, len);
    }
 
    void prints(const char* cstr) {
-      return intrinsics::get().call<intrinsics::prints>(cstr);
+      return intrinsics::call<intrinsics::prints>(cstr);
    }
 
    void printi(int64_t value) {
-      return intrinsics::get().call<intrinsics::printi>(value);
+      return intrinsics::call<intrinsics::printi>(value);
    }
 
    void printui(uint64_t value) {
-      return intrinsics::get().call<intrinsics::printui>(value);
+      return intrinsics::call<intrinsics::printui>(value);
    }
    
    void printi128(const int128_t* value) {
-      return intrinsics::get().call<intrinsics::printi128>(value);
+      return intrinsics::call<intrinsics::printi128>(value);
    }
 
     void printui128(const uint128_t* value) {
-      return intrinsics::get().call<intrinsics::printui128>(value);
+      return intrinsics::call<intrinsics::printui128>(value);
    }
   
    void printsf(float value) {
-      return intrinsics::get().call<intrinsics::printsf>(value);
+      return intrinsics::call<intrinsics::printsf>(value);
    }
 
    void printdf(double value) {
-      return intrinsics::get().call<intrinsics::printdf>(value);
+      return intrinsics::call<intrinsics::printdf>(value);
    }
 
    void printqf(const long double* value) {
-      return intrinsics::get().call<intrinsics::printqf>(value);
+      return intrinsics::call<intrinsics::printqf>(value);
    }
    
    void printn(uint64_t nm) {
-      return intrinsics::get().call<intrinsics::printn>(nm);
+      return intrinsics::call<intrinsics::printn>(nm);
    }
    
    void printhex(const void* data, uint32_t len) {
-      return intrinsics::get().call<intrinsics::printhex>(data, len);
+      return intrinsics::call<intrinsics::printhex>(data, len);
    }
 
    void* memset ( void* ptr, int value, size_t num ) {
@@ -159,6 +159,9 @@ intrinsic_macro(get_context_free_data)
 #define CREATE_ENUM(name) \
    name,
 
+#define GET_NAME(name) \
+   #name,
+
 #define GENERATE_TYPE_MAPPING(name) \
    struct __ ## name ## _types { \
       using deduced_full_ts = decltype(eosio::native::get_args_full(::name)); \
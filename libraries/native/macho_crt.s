@@ -1,6 +1,8 @@
 .global start
 .global ____putc
+.global ____write
 .global __mmap
+.global ____clock_ns
 .global _setjmp
 .global _longjmp
 
@@ -26,6 +28,17 @@ ____putc:
    inc %rsp
    mov %r8, %rbx
    ret
+
+____write:
+   mov %rsi, %rdx  # length
+   mov %rdi, %rsi  # buffer
+   mov $1, %edi    # using stdout
+   mov $0x2000004, %eax    # write syscall 0x4
+   syscall
+   jnc 1f
+   neg %rax        # errors come back as a positive errno with the carry set
+1:
+   ret
   
 __mmap:
    mov $0x20000C5, %eax # mmap syscall 0xC5 or 197
@@ -38,6 +51,26 @@ __mmap:
    syscall
    ret 
 
+# gettimeofday, the wall clock: there is no monotonic clock syscall, mach_absolute_time lives in libSystem
+____clock_ns:
+   sub $16, %rsp
+   mov %rsp, %rdi        # timeval on the stack
+   mov $0, %rsi          # no timezone
+   mov $0, %rdx          # no mach_absolute_time
+   mov $0x2000074, %eax  # gettimeofday syscall 0x74
+   syscall
+   cmp $0, %rax          # older kernels return the time in rax:rdx instead of filling the timeval
+   jne 1f
+   mov 0(%rsp), %rax
+   mov 8(%rsp), %edx
+1:
+   mov %edx, %edx
+   imul $1000000000, %rax
+   imul $1000, %rdx
+   add %rdx, %rax
+   add $16, %rsp
+   ret
+
 _setjmp:
 	mov %rbx, 0(%rdi)
 	mov %rbp, 8(%rdi)
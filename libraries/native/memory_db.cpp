@@ -0,0 +1,521 @@
+#include <eosio/db.h>
+#include <eosio/system.h>
+#include "native/eosio/intrinsics.hpp"
+#include "native/eosio/memory_db.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eosio { namespace native {
+
+   namespace {
+      using table_key = std::tuple<uint64_t, uint64_t, uint64_t>; // code, scope, table
+
+      // Iterators to the rows and tables of one kind of index, numbered as the chain's iterator cache numbers them
+      template <typename Table, typename Row>
+      class iterator_cache {
+         public:
+            int32_t end_iterator( Table& tab ) {
+               if( tab.end_iterator == 0 ) {
+                  _tables.push_back( &tab );
+                  tab.end_iterator = -int32_t(_tables.size()) - 1;
+               }
+               return tab.end_iterator;
+            }
+
+            Table& get_table( int32_t end_itr ) {
+               eosio_assert( end_itr < -1, "not an end iterator" );
+               const size_t indx = -(end_itr + 2);
+               eosio_assert( indx < _tables.size(), "not a valid end iterator" );
+               return *_tables[indx];
+            }
+
+            Row& get( int32_t itr ) {
+               eosio_assert( itr != -1, "invalid iterator" );
+               eosio_assert( itr >= 0, "dereference of end iterator" );
+               eosio_assert( size_t(itr) < _rows.size(), "iterator out of range" );
+               eosio_assert( _rows[itr] != nullptr, "dereference of deleted object" );
+               return *_rows[itr];
+            }
+
+            int32_t add( Row& row ) {
+               auto res = _iterators.emplace( &row, int32_t(_rows.size()) );
+               if( res.second ) {
+                  end_iterator( *row.tab );
+                  _rows.push_back( &row );
+               }
+               return res.first->second;
+            }
+
+            void remove( int32_t itr ) {
+               _iterators.erase( _rows[itr] );
+               _rows[itr] = nullptr;
+            }
+
+            void clear() {
+               _tables.clear();
+               _rows.clear();
+               _iterators.clear();
+            }
+
+         private:
+            std::vector<Table*>                     _tables;
+            std::vector<Row*>                       _rows;
+            std::unordered_map<const Row*, int32_t> _iterators;
+      };
+
+      class primary_index {
+            struct table;
+            struct row {
+               uint64_t    primary;
+               uint64_t    payer;
+               std::string value;
+               table*      tab;
+            };
+            struct table {
+               uint64_t                code = 0;
+               std::map<uint64_t, row> rows;
+               int32_t                 end_iterator = 0;
+            };
+
+         public:
+            int32_t store( uint64_t receiver, uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len ) {
+               eosio_assert( payer != 0, "must specify a valid account to pay for new record" );
+               auto& tab = _tables[table_key{receiver, scope, table}];
+               tab.code = receiver;
+               auto res = tab.rows.try_emplace( id, row{id, payer, std::string((const char*)data, len), &tab} );
+               eosio_assert( res.second, "could not insert object, most likely a uniqueness constraint was violated" );
+               return _cache.add( res.first->second );
+            }
+
+            void update( uint64_t receiver, int32_t itr, uint64_t payer, const void* data, uint32_t len ) {
+               auto& r = _cache.get( itr );
+               eosio_assert( r.tab->code == receiver, "db access violation" );
+               if( payer != 0 )
+                  r.payer = payer;
+               r.value.assign( (const char*)data, len );
+            }
+
+            void remove( uint64_t receiver, int32_t itr ) {
+               auto& r = _cache.get( itr );
+               eosio_assert( r.tab->code == receiver, "db access violation" );
+               auto& tab = *r.tab;
+               const uint64_t primary = r.primary;
+               _cache.remove( itr );
+               tab.rows.erase( primary );
+            }
+
+            int32_t get( int32_t itr, void* data, uint32_t len ) {
+               const auto& r = _cache.get( itr );
+               if( len == 0 )
+                  return r.value.size();
+               const uint32_t copy_size = std::min( len, uint32_t(r.value.size()) );
+               memcpy( data, r.value.data(), copy_size );
+               return copy_size;
+            }
+
+            int32_t next( int32_t itr, uint64_t* primary ) {
+               if( itr < -1 )
+                  return -1; // cannot increment past the end iterator of a table
+               auto& r    = _cache.get( itr );
+               auto  next = std::next( r.tab->rows.find( r.primary ) );
+               if( next == r.tab->rows.end() )
+                  return _cache.end_iterator( *r.tab );
+               *primary = next->first;
+               return _cache.add( next->second );
+            }
+
+            int32_t previous( int32_t itr, uint64_t* primary ) {
+               if( itr < -1 ) {
+                  auto& tab = _cache.get_table( itr );
+                  if( tab.rows.empty() )
+                     return -1;
+                  *primary = tab.rows.rbegin()->first;
+                  return _cache.add( tab.rows.rbegin()->second );
+               }
+               auto& r   = _cache.get( itr );
+               auto  pos = r.tab->rows.find( r.primary );
+               if( pos == r.tab->rows.begin() )
+                  return -1; // cannot decrement past the first row of a table
+               --pos;
+               *primary = pos->first;
+               return _cache.add( pos->second );
+            }
+
+            int32_t find( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               return lookup( code, scope, table, [&]( auto& rows ) { return rows.find( id ); } );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               return lookup( code, scope, table, [&]( auto& rows ) { return rows.lower_bound( id ); } );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               return lookup( code, scope, table, [&]( auto& rows ) { return rows.upper_bound( id ); } );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto tab = find_table( code, scope, table );
+               return tab ? _cache.end_iterator( *tab ) : -1;
+            }
+
+            void clear() {
+               _cache.clear();
+               _tables.clear();
+            }
+
+         private:
+            // tables without rows do not exist, as the chain removes them with their last row
+            table* find_table( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto it = _tables.find( table_key{code, scope, table} );
+               return it == _tables.end() || it->second.rows.empty() ? nullptr : &it->second;
+            }
+
+            template <typename Search>
+            int32_t lookup( uint64_t code, uint64_t scope, uint64_t table, Search&& search ) {
+               auto tab = find_table( code, scope, table );
+               if( !tab )
+                  return -1;
+               const int32_t end_itr = _cache.end_iterator( *tab );
+               auto pos = search( tab->rows );
+               return pos == tab->rows.end() ? end_itr : _cache.add( pos->second );
+            }
+
+            std::map<table_key, table>  _tables;
+            iterator_cache<table, row>  _cache;
+      };
+
+      template <typename Secondary>
+      class secondary_index {
+            struct table;
+            struct row {
+               uint64_t  primary;
+               Secondary secondary;
+               uint64_t  payer;
+               table*    tab;
+            };
+            using secondary_key = std::pair<Secondary, uint64_t>;
+            struct table {
+               uint64_t                code = 0;
+               std::map<uint64_t, row> rows;
+               std::set<secondary_key> by_secondary;
+               int32_t                 end_iterator = 0;
+            };
+
+            static void check_secondary( const Secondary& secondary ) {
+               if constexpr( std::is_floating_point<Secondary>::value )
+                  eosio_assert( !std::isnan( secondary ), "NaN is not an allowed value for a secondary key" );
+            }
+
+         public:
+            int32_t store( uint64_t receiver, uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const Secondary& secondary ) {
+               eosio_assert( payer != 0, "must specify a valid account to pay for new record" );
+               check_secondary( secondary );
+               auto& tab = _tables[table_key{receiver, scope, table}];
+               tab.code = receiver;
+               auto res = tab.rows.try_emplace( id, row{id, secondary, payer, &tab} );
+               eosio_assert( res.second, "could not insert object, most likely a uniqueness constraint was violated" );
+               tab.by_secondary.emplace( secondary, id );
+               return _cache.add( res.first->second );
+            }
+
+            void update( uint64_t receiver, int32_t itr, uint64_t payer, const Secondary& secondary ) {
+               auto& r = _cache.get( itr );
+               eosio_assert( r.tab->code == receiver, "db access violation" );
+               check_secondary( secondary );
+               if( payer != 0 )
+                  r.payer = payer;
+               r.tab->by_secondary.erase( secondary_key{r.secondary, r.primary} );
+               r.secondary = secondary;
+               r.tab->by_secondary.emplace( secondary, r.primary );
+            }
+
+            void remove( uint64_t receiver, int32_t itr ) {
+               auto& r = _cache.get( itr );
+               eosio_assert( r.tab->code == receiver, "db access violation" );
+               auto& tab = *r.tab;
+               const uint64_t primary = r.primary;
+               _cache.remove( itr );
+               tab.by_secondary.erase( secondary_key{r.secondary, primary} );
+               tab.rows.erase( primary );
+            }
+
+            int32_t find_primary( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t primary ) {
+               auto tab = find_table( code, scope, table );
+               if( !tab )
+                  return -1;
+               const int32_t end_itr = _cache.end_iterator( *tab );
+               auto pos = tab->rows.find( primary );
+               if( pos == tab->rows.end() )
+                  return end_itr;
+               secondary = pos->second.secondary;
+               return _cache.add( pos->second );
+            }
+
+            int32_t find_secondary( uint64_t code, uint64_t scope, uint64_t table, const Secondary& secondary, uint64_t& primary ) {
+               check_secondary( secondary );
+               auto tab = find_table( code, scope, table );
+               if( !tab )
+                  return -1;
+               const int32_t end_itr = _cache.end_iterator( *tab );
+               auto pos = tab->by_secondary.lower_bound( secondary_key{secondary, 0} );
+               if( pos == tab->by_secondary.end() || secondary < pos->first )
+                  return end_itr;
+               primary = pos->second;
+               return _cache.add( tab->rows.at( pos->second ) );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t& primary ) {
+               return bound( code, scope, table, secondary, primary,
+                             [&]( auto& keys ) { return keys.lower_bound( secondary_key{secondary, 0} ); } );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t& primary ) {
+               return bound( code, scope, table, secondary, primary,
+                             [&]( auto& keys ) { return keys.upper_bound( secondary_key{secondary, std::numeric_limits<uint64_t>::max()} ); } );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto tab = find_table( code, scope, table );
+               return tab ? _cache.end_iterator( *tab ) : -1;
+            }
+
+            int32_t next( int32_t itr, uint64_t& primary ) {
+               if( itr < -1 )
+                  return -1; // cannot increment past the end iterator of an index
+               auto& r    = _cache.get( itr );
+               auto  next = std::next( r.tab->by_secondary.find( secondary_key{r.secondary, r.primary} ) );
+               if( next == r.tab->by_secondary.end() )
+                  return _cache.end_iterator( *r.tab );
+               primary = next->second;
+               return _cache.add( r.tab->rows.at( next->second ) );
+            }
+
+            int32_t previous( int32_t itr, uint64_t& primary ) {
+               if( itr < -1 ) {
+                  auto& tab = _cache.get_table( itr );
+                  if( tab.by_secondary.empty() )
+                     return -1;
+                  primary = tab.by_secondary.rbegin()->second;
+                  return _cache.add( tab.rows.at( primary ) );
+               }
+               auto& r   = _cache.get( itr );
+               auto  pos = r.tab->by_secondary.find( secondary_key{r.secondary, r.primary} );
+               if( pos == r.tab->by_secondary.begin() )
+                  return -1; // cannot decrement past the first row of an index
+               --pos;
+               primary = pos->second;
+               return _cache.add( r.tab->rows.at( pos->second ) );
+            }
+
+            void clear() {
+               _cache.clear();
+               _tables.clear();
+            }
+
+         private:
+            table* find_table( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto it = _tables.find( table_key{code, scope, table} );
+               return it == _tables.end() || it->second.rows.empty() ? nullptr : &it->second;
+            }
+
+            // the found secondary key is written back, as lowerbound and upperbound report the key they stopped at
+            template <typename Search>
+            int32_t bound( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t& primary, Search&& search ) {
+               check_secondary( secondary );
+               auto tab = find_table( code, scope, table );
+               if( !tab )
+                  return -1;
+               const int32_t end_itr = _cache.end_iterator( *tab );
+               auto pos = search( tab->by_secondary );
+               if( pos == tab->by_secondary.end() )
+                  return end_itr;
+               secondary = pos->first;
+               primary   = pos->second;
+               return _cache.add( tab->rows.at( pos->second ) );
+            }
+
+            std::map<table_key, table>  _tables;
+            iterator_cache<table, row>  _cache;
+      };
+
+      using key256 = std::array<uint128_t, 2>;
+
+      // constructed on first use, the native crt runs no static constructors
+      struct database {
+         uint64_t                     receiver = 0;
+         primary_index                primary;
+         secondary_index<uint64_t>    idx64;
+         secondary_index<uint128_t>   idx128;
+         secondary_index<key256>      idx256;
+         secondary_index<double>      idx_double;
+         secondary_index<long double> idx_long_double;
+
+         static database& get() {
+            static database inst;
+            return inst;
+         }
+      };
+
+      key256 to_key256( const uint128_t* data, uint32_t datalen ) {
+         eosio_assert( datalen == 2, "invalid size of secondary key array for idx256" );
+         key256 key;
+         memcpy( key.data(), data, sizeof(key) );
+         return key;
+      }
+   }
+
+   void memory_db::install() {
+      intrinsics::set_intrinsic<intrinsics::current_receiver>([]() {
+            return database::get().receiver;
+         });
+
+      intrinsics::set_intrinsic<intrinsics::db_store_i64>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const void* data, uint32_t len) {
+            auto& db = database::get();
+            return db.primary.store( db.receiver, scope, table, payer, id, data, len );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_update_i64>([](int32_t iterator, capi_name payer, const void* data, uint32_t len) {
+            auto& db = database::get();
+            db.primary.update( db.receiver, iterator, payer, data, len );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_remove_i64>([](int32_t iterator) {
+            auto& db = database::get();
+            db.primary.remove( db.receiver, iterator );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_get_i64>([](int32_t iterator, const void* data, uint32_t len) {
+            return database::get().primary.get( iterator, const_cast<void*>(data), len );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_next_i64>([](int32_t iterator, uint64_t* primary) {
+            return database::get().primary.next( iterator, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_previous_i64>([](int32_t iterator, uint64_t* primary) {
+            return database::get().primary.previous( iterator, primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_find_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+            return database::get().primary.find( code, scope, table, id );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_lowerbound_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+            return database::get().primary.lowerbound( code, scope, table, id );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_upperbound_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+            return database::get().primary.upperbound( code, scope, table, id );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_end_i64>([](capi_name code, uint64_t scope, capi_name table) {
+            return database::get().primary.end( code, scope, table );
+         });
+
+#define INSTALL_SECONDARY_INDEX(IDX, TYPE)                                                                                             \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_store>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const TYPE* secondary) { \
+            auto& db = database::get();                                                                                                \
+            return db.IDX.store( db.receiver, scope, table, payer, id, *secondary );                                                   \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_update>([](int32_t iterator, capi_name payer, const TYPE* secondary) {         \
+            auto& db = database::get();                                                                                                \
+            db.IDX.update( db.receiver, iterator, payer, *secondary );                                                                 \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_remove>([](int32_t iterator) {                                                  \
+            auto& db = database::get();                                                                                                \
+            db.IDX.remove( db.receiver, iterator );                                                                                    \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_find_primary>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t primary) { \
+            return database::get().IDX.find_primary( code, scope, table, *secondary, primary );                                        \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_find_secondary>([](capi_name code, uint64_t scope, capi_name table, const TYPE* secondary, uint64_t* primary) { \
+            return database::get().IDX.find_secondary( code, scope, table, *secondary, *primary );                                     \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_lowerbound>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t* primary) { \
+            return database::get().IDX.lowerbound( code, scope, table, *secondary, *primary );                                         \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_upperbound>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t* primary) { \
+            return database::get().IDX.upperbound( code, scope, table, *secondary, *primary );                                         \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_end>([](capi_name code, uint64_t scope, capi_name table) {                      \
+            return database::get().IDX.end( code, scope, table );                                                                      \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_next>([](int32_t iterator, uint64_t* primary) {                                 \
+            return database::get().IDX.next( iterator, *primary );                                                                     \
+         });                                                                                                                           \
+      intrinsics::set_intrinsic<intrinsics::db_##IDX##_previous>([](int32_t iterator, uint64_t* primary) {                             \
+            return database::get().IDX.previous( iterator, *primary );                                                                 \
+         });
+
+      INSTALL_SECONDARY_INDEX(idx64, uint64_t)
+      INSTALL_SECONDARY_INDEX(idx128, uint128_t)
+      INSTALL_SECONDARY_INDEX(idx_double, double)
+      INSTALL_SECONDARY_INDEX(idx_long_double, long double)
+#undef INSTALL_SECONDARY_INDEX
+
+      intrinsics::set_intrinsic<intrinsics::db_idx256_store>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint128_t* data, uint32_t datalen) {
+            auto& db = database::get();
+            return db.idx256.store( db.receiver, scope, table, payer, id, to_key256( data, datalen ) );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_update>([](int32_t iterator, capi_name payer, const uint128_t* data, uint32_t datalen) {
+            auto& db = database::get();
+            db.idx256.update( db.receiver, iterator, payer, to_key256( data, datalen ) );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_remove>([](int32_t iterator) {
+            auto& db = database::get();
+            db.idx256.remove( db.receiver, iterator );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_find_primary>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen, uint64_t primary) {
+            key256 key = to_key256( data, datalen );
+            const int32_t itr = database::get().idx256.find_primary( code, scope, table, key, primary );
+            memcpy( data, key.data(), sizeof(key) );
+            return itr;
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_find_secondary>([](capi_name code, uint64_t scope, capi_name table, const uint128_t* data, uint32_t datalen, uint64_t* primary) {
+            return database::get().idx256.find_secondary( code, scope, table, to_key256( data, datalen ), *primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_lowerbound>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen, uint64_t* primary) {
+            key256 key = to_key256( data, datalen );
+            const int32_t itr = database::get().idx256.lowerbound( code, scope, table, key, *primary );
+            memcpy( data, key.data(), sizeof(key) );
+            return itr;
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_upperbound>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t datalen, uint64_t* primary) {
+            key256 key = to_key256( data, datalen );
+            const int32_t itr = database::get().idx256.upperbound( code, scope, table, key, *primary );
+            memcpy( data, key.data(), sizeof(key) );
+            return itr;
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_end>([](capi_name code, uint64_t scope, capi_name table) {
+            return database::get().idx256.end( code, scope, table );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_next>([](int32_t iterator, uint64_t* primary) {
+            return database::get().idx256.next( iterator, *primary );
+         });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_previous>([](int32_t iterator, uint64_t* primary) {
+            return database::get().idx256.previous( iterator, *primary );
+         });
+   }
+
+   void memory_db::clear() {
+      auto& db = database::get();
+      db.primary.clear();
+      db.idx64.clear();
+      db.idx128.clear();
+      db.idx256.clear();
+      db.idx_double.clear();
+      db.idx_long_double.clear();
+   }
+
+   void memory_db::set_receiver( eosio::name receiver ) {
+      database::get().receiver = receiver.value;
+   }
+
+   eosio::name memory_db::get_receiver() {
+      return eosio::name{database::get().receiver};
+   }
+
+}} //ns eosio::native
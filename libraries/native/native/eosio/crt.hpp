@@ -1,5 +1,9 @@
 #pragma once
 #include <setjmp.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 namespace eosio { namespace cdt {
    enum output_stream_kind {
@@ -7,13 +11,67 @@ namespace eosio { namespace cdt {
       std_err,
       none
    };
+   /**
+    * Captures printed output. It starts in the inline buffer and moves to the heap when it outgrows it, doubling
+    * as needed up to max_capacity, past which the output is dropped and overflowed is set. The output is kept null
+    * terminated. All the members are zero when it is constructed, so it works without static constructors.
+    */
    struct output_stream {
-      char output[1024*2];
+      static constexpr size_t max_capacity = 16*1024*1024;
+
+      char   output[1024*2];
+      char*  heap_output = nullptr;
+      size_t heap_capacity = 0;
       size_t index = 0;
-      std::string to_string()const { return std::string((const char*)output, index); }
-      const char* get()const { return output; }
-      void push(char c) { output[index++] = c; }
-      void clear() { index = 0; }
+      bool   overflowed = false;
+
+      output_stream() = default;
+      output_stream(const output_stream&) = delete;
+      output_stream& operator=(const output_stream&) = delete;
+      ~output_stream() { free(heap_output); }
+
+      char* data() { return heap_output ? heap_output : output; }
+      const char* data()const { return heap_output ? heap_output : output; }
+      size_t capacity()const { return heap_output ? heap_capacity : sizeof(output); }
+
+      std::string to_string()const { return std::string(data(), index); }
+      const char* get()const { return data(); }
+      void push(char c) { append(&c, 1); }
+
+      void append(const char* cstr, size_t len) {
+         if (index + len >= capacity() && !grow(index + len + 1)) {
+            overflowed = true;
+            len = capacity() - 1 - index;
+         }
+         memcpy(data() + index, cstr, len);
+         index += len;
+         data()[index] = '\0';
+      }
+
+      void clear() {
+         index = 0;
+         overflowed = false;
+         data()[0] = '\0';
+      }
+
+      private:
+         // grows to hold size bytes or as close as max_capacity allows, returns whether size fits
+         bool grow(size_t size) {
+            if (capacity() >= max_capacity)
+               return false;
+            size_t new_capacity = capacity() * 2;
+            while (new_capacity < size && new_capacity < max_capacity)
+               new_capacity *= 2;
+            new_capacity = std::min(new_capacity, max_capacity);
+            char* new_output = static_cast<char*>(realloc(heap_output, new_capacity));
+            if (!new_output)
+               return false;
+            if (!heap_output)
+               memcpy(new_output, output, index);
+            heap_output   = new_output;
+            heap_capacity = new_capacity;
+            return size <= new_capacity;
+         }
    };
 }} //ns eosio::cdt
 
@@ -21,10 +79,13 @@ extern eosio::cdt::output_stream std_out;
 extern eosio::cdt::output_stream std_err;
 extern "C" jmp_buf* ___env_ptr;
 extern "C" char*    ___heap_ptr;
+extern "C" size_t   ___pages;
+extern "C" bool     ___quiet_output;
 
 extern "C" {
    void __set_env_test();
    void __reset_env();
    void _prints_l(const char* cstr, uint32_t len, uint8_t which);
    void _prints(const char* cstr, uint8_t which);
+   uint64_t ___clock_ns(); // monotonic on ELF, the wall clock on Mach-O
 }
@@ -1,10 +1,71 @@
 #include <eosio/action.hpp>
 #include "intrinsics_def.hpp"
+#include <array>
 
 #pragma once
 
 namespace eosio { namespace native {
-   
+
+   /**
+    * What one intrinsic is charged by the cost model: a cost for every call and one for every byte of buffer passed
+    */
+   struct intrinsic_cost {
+      uint64_t per_call = 0;
+      uint64_t per_byte = 0;
+   };
+
+   struct intrinsic_counter {
+      uint64_t calls = 0;
+      uint64_t bytes = 0; // total length of the void and char buffers passed
+   };
+
+   namespace detail {
+      template <typename T>
+      constexpr bool is_byte_buffer_v = std::is_pointer<T>::value &&
+         ( std::is_void<std::remove_cv_t<std::remove_pointer_t<T>>>::value ||
+           sizeof(std::remove_pointer_t<T>) == 1 );
+
+      // sums the lengths following the byte buffers in an argument list, e.g. (data, len) of db_get_i64
+      template <typename... Args>
+      inline uint64_t buffer_bytes(Args...) { return 0; }
+
+      template <typename T, typename U, typename... Args>
+      inline uint64_t buffer_bytes(T, U len, Args... rest) {
+         uint64_t bytes = 0;
+         if constexpr (is_byte_buffer_v<T> && std::is_integral<U>::value && !std::is_same<U, bool>::value)
+            bytes = len;
+         return bytes + buffer_bytes(len, rest...);
+      }
+   }
+
+   /**
+    * An entry of the dispatch table of the intrinsics: a plain function pointer and the user data it is called with
+    */
+   template <typename F>
+   struct intrinsic_dispatch;
+
+   template <typename R, typename... Args>
+   struct intrinsic_dispatch<std::function<R(Args...)>> {
+      using result_type  = R;
+      using function_ptr = R(*)(void*, Args...);
+
+      function_ptr func;
+      void*        user_data;
+
+      // callables set for an intrinsic returning void may still return a value, which is dropped
+      template <typename F>
+      static R invoke(void* user_data, Args... args) {
+         if constexpr (std::is_void<R>::value)
+            (*static_cast<F*>(user_data))(args...);
+         else
+            return (*static_cast<F*>(user_data))(args...);
+      }
+
+      static R unsupported(void*, Args...) {
+         eosio_assert(false, "unsupported intrinsic"); return (R)0;
+      }
+   };
+
    class intrinsics {
       public:
          static intrinsics& get() {
@@ -23,22 +84,107 @@ namespace eosio { namespace native {
             std::function<void()>{[](){}}
          };
 
+         static constexpr const char* names[] = {
+            INTRINSICS(GET_NAME)
+         };
+
+         template <intrinsic_name IN>
+         using function_type = std::tuple_element_t<IN, decltype(funcs)>;
+
+         template <intrinsic_name IN>
+         using dispatch_type = intrinsic_dispatch<function_type<IN>>;
+
+         // constant initialized, so the call sites reach it without going through get()
+         template <intrinsic_name IN>
+         static inline dispatch_type<IN> dispatch = { &dispatch_type<IN>::unsupported, nullptr };
+
+         static inline bool counting = false;
+         static inline std::array<intrinsic_counter, INTRINSICS_SIZE> counters = {};
+         static inline std::array<intrinsic_cost, INTRINSICS_SIZE> costs = {};
+
          template <intrinsic_name IN, typename... Args>
-         auto call(Args... args) -> decltype(std::get<IN>(intrinsics::get().funcs)(args...)) {
-            return std::get<IN>(intrinsics::get().funcs)(args...); 
+         static inline auto call(Args... args) -> typename dispatch_type<IN>::result_type {
+            if (counting) {
+               counters[IN].calls++;
+               counters[IN].bytes += detail::buffer_bytes(args...);
+            }
+            const auto& entry = dispatch<IN>;
+            return entry.func(entry.user_data, args...);
          }
 
+         /**
+          * Defines an intrinsic with a callable, which the dispatch table then calls directly instead of through the
+          * std::function returned by get_intrinsic
+          */
          template <intrinsic_name IN, typename F>
          static void set_intrinsic(F&& func) {
+            using callable_type = std::decay_t<F>;
             auto& f = std::get<IN>(intrinsics::get().funcs);
-            std::get<IN>(intrinsics::get().funcs) = typename std::remove_reference<decltype(f)>::type {func};
+            f = function_type<IN>{func};
+            if (auto* target = f.template target<callable_type>())
+               dispatch<IN> = { &dispatch_type<IN>::template invoke<callable_type>, target };
+            else
+               dispatch<IN> = { &dispatch_type<IN>::template invoke<function_type<IN>>, &f };
          }
-         
+
+         /**
+          * Defines an intrinsic with a plain function, which is passed user_data ahead of the arguments of the intrinsic
+          */
+         template <intrinsic_name IN>
+         static void set_intrinsic(typename dispatch_type<IN>::function_ptr func, void* user_data) {
+            std::get<IN>(intrinsics::get().funcs) = [func, user_data](auto... args) { return func(user_data, args...); };
+            dispatch<IN> = { func, user_data };
+         }
+
          template <intrinsic_name IN>
-         static auto get_intrinsic() 
-               -> typename std::remove_reference<decltype(std::get<IN>(intrinsics::get().funcs))>::type {
+         static auto get_intrinsic() -> function_type<IN> {
             return std::get<IN>(intrinsics::get().funcs);
          }
+
+         template <intrinsic_name IN>
+         static void* get_user_data() {
+            return dispatch<IN>.user_data;
+         }
+
+         /**
+          * Starts or stops counting the calls and buffer bytes of every intrinsic
+          */
+         static void count_calls(bool enable) {
+            counting = enable;
+         }
+
+         static bool counting_calls() {
+            return counting;
+         }
+
+         static void reset_counters() {
+            counters = {};
+         }
+
+         static const intrinsic_counter& get_counter(intrinsic_name in) {
+            return counters[in];
+         }
+
+         /**
+          * Sets what the cost model charges for the calls to an intrinsic, every intrinsic costs nothing by default
+          */
+         static void set_cost(intrinsic_name in, intrinsic_cost cost) {
+            costs[in] = cost;
+         }
+
+         static const intrinsic_cost& get_cost(intrinsic_name in) {
+            return costs[in];
+         }
+
+         static uint64_t cost_of(intrinsic_name in) {
+            const auto& counter = get_counter(in);
+            const auto& cost    = get_cost(in);
+            return counter.calls * cost.per_call + counter.bytes * cost.per_byte;
+         }
+
+         static const char* name_of(intrinsic_name in) {
+            return names[in];
+         }
    };
 
 }} //ns eosio::native
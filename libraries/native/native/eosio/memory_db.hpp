@@ -0,0 +1,36 @@
+#pragma once
+#include <eosio/name.hpp>
+
+namespace eosio { namespace native {
+
+   /**
+    * An ordered in-memory backend for the db_* intrinsics of native builds.
+    *
+    * It keeps the primary index and every secondary index (idx64, idx128, idx256, idx_double and idx_long_double)
+    * of each table sorted, and hands out iterators the way the chain does: -1 for a table that does not exist, a
+    * negative end iterator per table below that, and one iterator per row which is reused while the row exists.
+    * Rows are stored under the receiver, which current_receiver() returns as well.
+    *
+    * The native crt installs it before main(), so multi_index and singleton work in native tests without a node.
+    * Single intrinsics can still be replaced afterwards with intrinsics::set_intrinsic.
+    */
+   class memory_db {
+      public:
+         /**
+          * Routes every db_* intrinsic and current_receiver to the in-memory tables
+          */
+         static void install();
+
+         /**
+          * Drops every table and invalidates every iterator
+          */
+         static void clear();
+
+         /**
+          * Sets the account the rows stored from now on belong to, and current_receiver() returns
+          */
+         static void set_receiver( eosio::name receiver );
+         static eosio::name get_receiver();
+   };
+
+}} //ns eosio::native
@@ -3,6 +3,9 @@
 #include "crt.hpp"
 #include "intrinsics.hpp"
 #include <setjmp.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
 #include <vector>
 
 extern "C" bool ___disable_output;
@@ -11,6 +14,11 @@ extern "C" bool ___has_failed;
 inline void silence_output(bool t) {
    ___disable_output = t;
 }
+
+// drops the printed output before it is formatted, captured or written, assert messages are still captured
+inline void quiet_output(bool t) {
+   ___quiet_output = t;
+}
 inline bool has_failed() {
    return ___has_failed;
 }
@@ -100,7 +108,68 @@ inline bool expect_print(bool check, const std::string& li, const char (&expecte
 #define REQUIRE_EQUAL(X, Y) \
    eosio::check(X == Y, std::string(std::string("REQUIRE_EQUAL failed (")+#X+" != "+#Y+") {"+__FILE__+":"+std::to_string(__LINE__)+"}").c_str());
  
+// left-aligns a column of the intrinsic report
+inline std::string report_column(std::string text, size_t width) {
+   if (text.size() < width)
+      text.append(width - text.size(), ' ');
+   return text;
+}
+
+/**
+ * Prints the calls, buffer bytes and cost of every intrinsic called since the counters were last reset, the most
+ * expensive first, then resets the counters. Does nothing unless intrinsics::count_calls(true) was called.
+ */
+inline void print_intrinsic_report(const char* label) {
+   using eosio::native::intrinsics;
+   if (!intrinsics::counting_calls())
+      return;
+   intrinsics::count_calls(false);
+
+   std::vector<intrinsics::intrinsic_name> called;
+   uint64_t calls = 0, bytes = 0, cost = 0;
+   for (int i = 0; i < intrinsics::INTRINSICS_SIZE; i++) {
+      const auto in = static_cast<intrinsics::intrinsic_name>(i);
+      if (intrinsics::get_counter(in).calls == 0)
+         continue;
+      called.push_back(in);
+      calls += intrinsics::get_counter(in).calls;
+      bytes += intrinsics::get_counter(in).bytes;
+      cost  += intrinsics::cost_of(in);
+   }
+   std::stable_sort(called.begin(), called.end(), [](auto a, auto b) {
+      if (intrinsics::cost_of(a) != intrinsics::cost_of(b))
+         return intrinsics::cost_of(a) > intrinsics::cost_of(b);
+      return intrinsics::get_counter(a).calls > intrinsics::get_counter(b).calls;
+   });
+
+   bool disable_out = ___disable_output;
+   silence_output(false);
+   eosio::print("\033[1;37m", label, " \033[0;37mintrinsics: ", calls, " calls, ", bytes, " bytes, cost ", cost, "\033[0m\n");
+   for (const auto in : called) {
+      const auto& counter = intrinsics::get_counter(in);
+      eosio::print("   ", report_column(intrinsics::name_of(in), 40),
+                   report_column(std::to_string(counter.calls) + " calls", 16),
+                   report_column(std::to_string(counter.bytes) + " bytes", 20),
+                   "cost ", intrinsics::cost_of(in), "\n");
+   }
+   silence_output(disable_out);
+
+   intrinsics::reset_counters();
+   intrinsics::count_calls(true);
+}
+
+/**
+ * Runs func, an action for instance, and prints the report of the intrinsics it called
+ */
+template <typename F>
+inline void report_intrinsics(const char* label, F&& func) {
+   eosio::native::intrinsics::reset_counters();
+   func();
+   print_intrinsic_report(label);
+}
+
 #define EOSIO_TEST(X) \
+   eosio::native::intrinsics::reset_counters(); \
    int X ## _ret = setjmp(*___env_ptr); \
    if ( X ## _ret == 0 ) \
       X(); \
@@ -116,7 +185,139 @@ inline bool expect_print(bool check, const std::string& li, const char (&expecte
       static constexpr const char* __test_name = #X;
 
 #define EOSIO_TEST_END \
+      print_intrinsic_report(__test_name); \
       silence_output(false); \
       eosio::print("\033[1;37m",__test_name," \033[0;37munit test \033[1;32mpassed\033[0m\n"); \
       silence_output(___disable_output); \
    }
+
+struct bench_config {
+   uint32_t warmup    = 5;       // samples run and dropped before measuring
+   uint32_t samples   = 51;      // timed samples the percentiles are taken from
+   uint64_t sample_ns = 1000000; // the iterations of a sample are doubled until one takes this long
+   bool     json      = false;   // print one JSON object per benchmark instead of a line of text
+};
+
+inline bench_config& bench_settings() {
+   static bench_config config;
+   return config;
+}
+
+// --json, --samples=N, --warmup=N and --sample-ns=N override the settings
+inline void bench_parse_args(int argc, char** argv) {
+   auto& config = bench_settings();
+   const auto value = [](const std::string& arg, const char* flag) {
+      return strtoull(arg.c_str() + strlen(flag), nullptr, 10);
+   };
+   for (int i = 1; i < argc; i++) {
+      const std::string arg = argv[i];
+      if (arg == "--json")
+         config.json = true;
+      else if (arg.rfind("--samples=", 0) == 0)
+         config.samples = std::max<uint64_t>(value(arg, "--samples="), 1);
+      else if (arg.rfind("--warmup=", 0) == 0)
+         config.warmup = value(arg, "--warmup=");
+      else if (arg.rfind("--sample-ns=", 0) == 0)
+         config.sample_ns = value(arg, "--sample-ns=");
+   }
+}
+
+// keeps the computation of a value from being optimized away
+template <typename T>
+inline void bench_do_not_optimize(const T& value) {
+   asm volatile("" : : "g"(&value) : "memory");
+}
+
+struct bench_result {
+   std::string name;
+   uint64_t    median_ps  = 0;
+   uint64_t    p95_ps     = 0;
+   uint64_t    p99_ps     = 0;
+   uint64_t    heap_bytes = 0; // growth of the heap over all the timed iterations
+   uint64_t    heap_pages = 0;
+   uint32_t    samples    = 0;
+   uint64_t    iterations = 0; // per sample
+};
+
+template <typename F>
+inline bench_result run_bench(const char* name, F&& op) {
+   const auto& config = bench_settings();
+   const auto time_sample = [&](uint64_t iterations) {
+      const uint64_t start = ___clock_ns();
+      for (uint64_t i = 0; i < iterations; i++)
+         op();
+      // the Mach-O clock follows the wall clock, a sample it stepped back over reads as zero instead of wrapping
+      const uint64_t end = ___clock_ns();
+      return end > start ? end - start : 0;
+   };
+
+   bench_result result;
+   result.name       = name;
+   result.samples    = config.samples;
+   result.iterations = 1;
+   while (time_sample(result.iterations) < config.sample_ns && result.iterations < (uint64_t(1) << 32))
+      result.iterations *= 2;
+   for (uint32_t i = 0; i < config.warmup; i++)
+      time_sample(result.iterations);
+
+   std::vector<uint64_t> sample_ps(config.samples);
+   const char*  heap_before  = ___heap_ptr;
+   const size_t pages_before = ___pages;
+   for (auto& ps : sample_ps)
+      ps = time_sample(result.iterations) * 1000 / result.iterations;
+   result.heap_bytes = ___heap_ptr - heap_before;
+   result.heap_pages = ___pages - pages_before;
+
+   // nearest rank percentiles
+   std::sort(sample_ps.begin(), sample_ps.end());
+   const auto percentile = [&](uint64_t p) { return sample_ps[(p * sample_ps.size() + 99) / 100 - 1]; };
+   result.median_ps = percentile(50);
+   result.p95_ps    = percentile(95);
+   result.p99_ps    = percentile(99);
+   return result;
+}
+
+// numerator / denominator with two decimals
+inline std::string bench_fixed(uint64_t numerator, uint64_t denominator) {
+   const uint64_t hundredths = numerator * 100 / denominator;
+   const uint64_t fraction   = hundredths % 100;
+   return std::to_string(hundredths / 100) + (fraction < 10 ? ".0" : ".") + std::to_string(fraction);
+}
+
+inline void print_bench_result(const bench_result& r) {
+   const std::string median   = bench_fixed(r.median_ps, 1000);
+   const std::string p95      = bench_fixed(r.p95_ps, 1000);
+   const std::string p99      = bench_fixed(r.p99_ps, 1000);
+   const std::string heap     = bench_fixed(r.heap_bytes, r.samples * r.iterations);
+   if (bench_settings().json)
+      eosio::print("{\"name\":\"", r.name, "\",\"median_ns\":", median, ",\"p95_ns\":", p95, ",\"p99_ns\":", p99,
+                   ",\"heap_bytes_per_op\":", heap, ",\"heap_pages\":", r.heap_pages,
+                   ",\"samples\":", r.samples, ",\"iterations\":", r.iterations, "}\n");
+   else
+      eosio::print("\033[1;37m", r.name, " \033[0;37mbenchmark \033[1;32m", median, " ns/op\033[0m",
+                   " (p95 ", p95, " ns, p99 ", p99, " ns, heap ", heap, " B/op, ",
+                   r.samples, " samples of ", r.iterations, ")\n");
+}
+
+#define EOSIO_BENCH(X) \
+   int X ## _ret = setjmp(*___env_ptr); \
+   if ( X ## _ret == 0 ) { \
+      const bench_result X ## _result = X(); \
+      silence_output(false); \
+      print_bench_result(X ## _result); \
+      silence_output(___disable_output); \
+   } else { \
+      silence_output(false); \
+      eosio::print("\033[1;37m", #X, " \033[0;37mbenchmark \033[1;31mfailed\033[0m\n"); \
+      ___has_failed = true; \
+      silence_output(___disable_output); \
+   }
+
+// The body is one operation, timed over repeated iterations; state set up once can live in static locals
+#define EOSIO_BENCH_BEGIN(X) \
+   struct X ## _bench { static void op(); }; \
+   bench_result X() { return run_bench(#X, []() { X ## _bench::op(); }); } \
+   void X ## _bench::op() {
+
+#define EOSIO_BENCH_END \
+   }
@@ -67,6 +67,17 @@ BOOST_FIXTURE_TEST_CASE( simple_tests, tester ) try {
    BOOST_CHECK_THROW(push_action(N(test), N(testc), N(test), mvo() ("nm", "someone")), fc::exception);
    push_action(N(test), N(testc), N(test), mvo() ("nm", "quit"));
 
+   // by value, const reference and std::string_view parameters
+   push_action(N(test), N(byvalue), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("ids", fc::variants{1, 2, 3}));
+   BOOST_CHECK_THROW(push_action(N(test), N(byvalue), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("ids", fc::variants{1, 2})), fc::exception);
+   push_action(N(test), N(byref), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("ids", fc::variants{1, 2, 3}));
+   BOOST_CHECK_THROW(push_action(N(test), N(byref), N(test), mvo() ("nm", "bucky") ("memo", "not some string") ("ids", fc::variants{1, 2, 3})), fc::exception);
+   push_action(N(test), N(byview), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("count", 33));
+   BOOST_CHECK_THROW(push_action(N(test), N(byview), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("count", 30)), fc::exception);
+   push_action(N(test), N(viewonly), N(test), mvo() ("memo", "some string"));
+   BOOST_CHECK_THROW(push_action(N(test), N(viewonly), N(test), mvo() ("memo", "not some string")), fc::exception);
+   push_action(N(test), N(bymixed), N(test), mvo() ("nm", "bucky") ("memo", "some string") ("view", "other string") ("moved", fc::variants{"a", "b"}));
+
 } FC_LOG_AND_RETHROW()
 
 BOOST_FIXTURE_TEST_CASE( simple_eosio_tests, tester ) try {
@@ -35,3 +35,18 @@ BOOST_FIXTURE_TEST_CASE( malloc_tests, tester ) try {
                           eosio_assert_message_is("failed to allocate pages") );
                           */
 } FC_LOG_AND_RETHROW() }
+
+BOOST_FIXTURE_TEST_CASE( scm_malloc_tests, tester ) try {
+   create_accounts( { N(test) } );
+   produce_block();
+
+   set_code( N(test), contracts::scm_malloc_tests_wasm() );
+   set_abi( N(test), contracts::scm_malloc_tests_abi().data() );
+   produce_blocks();
+
+   push_action(N(test), N(freelist), N(test), {});
+   push_action(N(test), N(releasetop), N(test), {});
+   push_action(N(test), N(realloctop), N(test), {});
+   push_action(N(test), N(hugereuse), N(test), {});
+   push_action(N(test), N(calloczero), N(test), {});
+} FC_LOG_AND_RETHROW() }
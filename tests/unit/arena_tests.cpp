@@ -0,0 +1,128 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/arena.hpp>
+
+using eosio::arena;
+using eosio::arena_allocator;
+using eosio::arena_scope;
+
+// Definitions in `eosio.cdt/libraries/eosio/arena.hpp`
+EOSIO_TEST_BEGIN(arena_test)
+   silence_output(false);
+
+   //// void* allocate(size_t, size_t)
+   {
+      arena a{64};
+      char* p0 = static_cast<char*>( a.allocate(1, 1) );
+      char* p1 = static_cast<char*>( a.allocate(1, 1) );
+      CHECK_EQUAL( p1 - p0, 1 )
+
+      void* p2 = a.allocate(8, 16);
+      CHECK_EQUAL( reinterpret_cast<uintptr_t>(p2) % 16, 0 )
+
+      // larger than the block size
+      char* big = static_cast<char*>( a.allocate(1000, 1) );
+      big[0] = big[999] = 'x';
+      CHECK_EQUAL( big[999], 'x' )
+
+      CHECK_ASSERT( "arena allocation is too large", [&](){a.allocate(std::numeric_limits<size_t>::max());} )
+   }
+
+   //// marker mark()const
+   //// void rewind(const marker&)
+   {
+      arena a{64};
+      a.allocate(8, 1);
+      const auto m = a.mark();
+      void* p0 = a.allocate(8, 1);
+      for ( int i = 0; i < 100; ++i )
+         a.allocate(16, 1);
+      a.rewind(m);
+      CHECK_EQUAL( a.allocate(8, 1), p0 )
+   }
+
+   //// void reset()
+   {
+      arena a{64};
+      void* p0 = a.allocate(32, 1);
+      for ( int i = 0; i < 10; ++i )
+         a.allocate(48, 1);
+      a.reset();
+      CHECK_EQUAL( a.allocate(32, 1), p0 )
+
+      // blocks are reused after a reset
+      std::vector<void*> first;
+      for ( int i = 0; i < 10; ++i )
+         first.push_back( a.allocate(48, 1) );
+      a.reset();
+      a.allocate(32, 1);
+      for ( int i = 0; i < 10; ++i )
+         CHECK_EQUAL( a.allocate(48, 1), first[i] )
+   }
+
+   //// arena_scope(arena&)
+   {
+      arena a;
+      void* p0 = nullptr;
+      {
+         arena_scope scope(a);
+         p0 = a.allocate(24);
+         {
+            arena_scope inner(a);
+            a.allocate(100);
+         }
+         CHECK_EQUAL( a.allocate(24) != p0, true )
+      }
+      CHECK_EQUAL( a.allocate(24), p0 )
+   }
+
+   //// void release()
+   {
+      arena a{64};
+      a.allocate(16);
+      a.release();
+      CHECK_EQUAL( a.allocate(16) != nullptr, true )
+   }
+
+   //// arena_allocator<T>
+   {
+      arena a{256};
+      for ( int round = 0; round < 3; ++round ) {
+         arena_scope scope(a);
+
+         std::vector<uint64_t, arena_allocator<uint64_t>> v(a);
+         for ( uint64_t i = 0; i < 1000; ++i )
+            v.push_back(i);
+         CHECK_EQUAL( v.size(), 1000 )
+         CHECK_EQUAL( v[999], 999 )
+
+         using astring = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+         astring s(a);
+         s.append(100, 'a');
+         CHECK_EQUAL( s.size(), 100 )
+
+         std::map<uint64_t, astring, std::less<uint64_t>, arena_allocator<std::pair<const uint64_t, astring>>> m(a);
+         m.emplace(1, astring("one", a));
+         m.emplace(2, astring("two", a));
+         CHECK_EQUAL( m.size(), 2 )
+         CHECK_EQUAL( (m.at(2) == "two"), true )
+
+         CHECK_EQUAL( (arena_allocator<int>(a) == arena_allocator<char>(a)), true )
+         arena other;
+         CHECK_EQUAL( (arena_allocator<int>(a) != arena_allocator<int>(other)), true )
+      }
+   }
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(arena_test);
+   return has_failed();
+}
@@ -3,6 +3,7 @@
  *  @copyright defined in eosio.cdt/LICENSE.txt
  */
 
+#include <cstdio>
 #include <string>
 
 #include <eosio/tester.hpp>
@@ -20,6 +21,39 @@ static constexpr int64_t asset_mask{(1LL << 62) - 1};
 static constexpr int64_t asset_min{-asset_mask}; // -4611686018427387903
 static constexpr int64_t asset_max{ asset_mask}; //  4611686018427387903
 
+// asset::to_string() as it was written before write_as_string()
+static string snprintf_to_string( const asset& a ) {
+   int64_t p = (int64_t)a.symbol.precision();
+   int64_t p10 = 1;
+   int64_t invert = 1;
+
+   while( p > 0  ) {
+      p10 *= 10; --p;
+   }
+   p = (int64_t)a.symbol.precision();
+
+   char fraction[p+1];
+   fraction[p] = '\0';
+
+   if (a.amount < 0) {
+      invert = -1;
+   }
+
+   auto change = (a.amount % p10) * invert;
+
+   for( int64_t i = p -1; i >= 0; --i ) {
+      fraction[i] = (change % 10) + '0';
+      change /= 10;
+   }
+   char str[p+32];
+   snprintf(str, sizeof(str), "%lld%s%s %s",
+      (int64_t)(a.amount/p10),
+      (fraction[0]) ? "." : "",
+      fraction,
+      a.symbol.code().to_string().c_str());
+   return {str};
+}
+
 // Definitions in `eosio.cdt/libraries/eosio/asset.hpp`
 EOSIO_TEST_BEGIN(asset_type_test)
    silence_output(true);
@@ -183,6 +217,26 @@ EOSIO_TEST_BEGIN(asset_type_test)
                    (std::string(std::string("0.") + std::string(precision, '0') + std::string(" SYMBOLL"))) )
    }
 
+   // ----------------------------------------
+   // char* write_as_string(char*, char*)const
+   char buffer[29 + 63];
+   CHECK_EQUAL( (asset{-15000LL, symbol{"SYS", 4}}.write_as_string( buffer, buffer + 32 ) == buffer), true )
+   char* end = asset{-15000LL, symbol{"SYS", 4}}.write_as_string( buffer, buffer + 33 );
+   CHECK_EQUAL( string(buffer, end), "-1.5000 SYS" )
+   end = asset{asset_max, sym_prec}.write_as_string( buffer, buffer + sizeof(buffer) );
+   CHECK_EQUAL( string(buffer, end), "0.000000000000000000000000000000000000000000004611686018427387903 SYMBOLL" )
+
+   // the same strings as the snprintf based formatting of earlier releases
+   uint64_t x = 88172645463325252ULL;
+   for( uint8_t precision{0}; precision < 64; ++precision ) {
+      for( int i = 0; i < 64; ++i ) {
+         x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+         const int64_t amount = int64_t(x % uint64_t(asset_max)) >> (x % 62);
+         const asset a{i % 2 ? -amount : amount, symbol{"SYMBOLL", precision}};
+         CHECK_EQUAL( a.to_string(), snprintf_to_string(a) )
+      }
+   }
+
    // ----------------------
    // asset operator-()const
    CHECK_EQUAL( (-asset{ 0LL, sym_no_prec}.amount), (asset{0LL, sym_no_prec}.amount) )
@@ -376,6 +430,15 @@ EOSIO_TEST_BEGIN(extended_asset_type_test)
    CHECK_EQUAL( (extended_asset{{},ext_sym_no_prec}.get_extended_symbol()), (ext_sym_no_prec) )
    CHECK_EQUAL( (extended_asset{{},ext_sym_prec}.get_extended_symbol()), (ext_sym_prec) )
 
+   // ----------------------------------------
+   // char* write_as_string(char*, char*)const
+   // std::string to_string()const
+   CHECK_EQUAL( (extended_asset{asset{11LL, symbol{"A", 1}}, name{"eosioaccountj"}}.to_string()), "1.1 A@eosioaccountj" )
+   CHECK_EQUAL( (extended_asset{asset{-11LL, symbol{"ZZZZZZZ", 0}}, name{"zzzzzzzzzzzzj"}}.to_string()), "-11 ZZZZZZZ@zzzzzzzzzzzzj" )
+   char ext_buffer[43 + 1];
+   CHECK_EQUAL( (extended_asset{asset{11LL, symbol{"A", 1}}, name{"a"}}.write_as_string( ext_buffer, ext_buffer + 43 ) == ext_buffer), true )
+   CHECK_EQUAL( (extended_asset{asset{11LL, symbol{"A", 1}}, name{"a"}}.write_as_string( ext_buffer, ext_buffer + 44 ) == ext_buffer + 7), true )
+
    // -----------------
    // void print()const
    CHECK_PRINT( "0 A@1", [](){extended_asset{asset{int64_t{0}, symbol{"A", 0}}, name{"1"}}.print();} )
@@ -527,8 +590,48 @@ EOSIO_TEST_BEGIN(extended_asset_type_test)
    silence_output(false);
 EOSIO_TEST_END
 
+static constexpr size_t bench_count = 1024;
+
+// Typical token amounts, with either precision
+static const asset* bench_assets() {
+   static asset assets[bench_count];
+   static const bool filled = [] {
+      uint64_t x = 88172645463325252ULL;
+      for( size_t i = 0; i < bench_count; ++i ) {
+         x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+         assets[i] = asset{int64_t(x % 100000000000ULL), symbol{"SYS", uint8_t(x % 2 ? 4 : 8)}};
+      }
+      return true;
+   }();
+   bench_do_not_optimize( filled );
+   return assets;
+}
+
+// snprintf against to_string() and write_as_string()
+EOSIO_BENCH_BEGIN(asset_snprintf_bench)
+   static size_t i = 0;
+   bench_do_not_optimize( snprintf_to_string( bench_assets()[i++ % bench_count] ) );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(asset_format_to_string_bench)
+   static size_t i = 0;
+   bench_do_not_optimize( bench_assets()[i++ % bench_count].to_string() );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(asset_write_as_string_bench)
+   static size_t i = 0;
+   char buffer[29 + 8];
+   bench_do_not_optimize( bench_assets()[i++ % bench_count].write_as_string( buffer, buffer + sizeof(buffer) ) );
+   bench_do_not_optimize( buffer );
+EOSIO_BENCH_END
+
 int main(int argc, char* argv[]) {
    EOSIO_TEST(asset_type_test);
    EOSIO_TEST(extended_asset_type_test);
+
+   bench_parse_args(argc, argv);
+   EOSIO_BENCH(asset_snprintf_bench);
+   EOSIO_BENCH(asset_format_to_string_bench);
+   EOSIO_BENCH(asset_write_as_string_bench);
    return has_failed();
 }
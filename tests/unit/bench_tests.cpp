@@ -0,0 +1,156 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/memory_db.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+
+using std::string;
+using std::vector;
+
+using eosio::asset;
+using eosio::indexed_by;
+using eosio::const_mem_fun;
+using eosio::multi_index;
+using eosio::name;
+using eosio::pack;
+using eosio::symbol;
+using eosio::unpack;
+using eosio::native::memory_db;
+
+struct bench_row {
+   uint64_t id;
+   name     owner;
+   string   memo;
+
+   uint64_t primary_key()const { return id; }
+   uint64_t by_owner()const { return owner.value; }
+
+   EOSLIB_SERIALIZE( bench_row, (id)(owner)(memo) )
+};
+
+using bench_table = multi_index<"benchrows"_n, bench_row,
+   indexed_by<"byowner"_n, const_mem_fun<bench_row, uint64_t, &bench_row::by_owner>>
+>;
+
+// Definitions in `eosio.cdt/libraries/native/native/eosio/tester.hpp`
+EOSIO_TEST_BEGIN(bench_runner_test)
+   silence_output(true);
+   const bench_config saved = bench_settings();
+
+   //// void bench_parse_args(int, char**)
+   char prog[] = "bench_tests", json[] = "--json", samples[] = "--samples=7", warmup[] = "--warmup=2",
+        sample_ns[] = "--sample-ns=1000", other[] = "--other";
+   char* argv[] = { prog, json, samples, warmup, sample_ns, other };
+   bench_parse_args( 6, argv );
+   CHECK_EQUAL( bench_settings().json, true )
+   CHECK_EQUAL( bench_settings().samples, 7 )
+   CHECK_EQUAL( bench_settings().warmup, 2 )
+   CHECK_EQUAL( bench_settings().sample_ns, 1000 )
+
+   //// bench_result run_bench(const char*, F&&)
+   uint64_t calls = 0;
+   const bench_result r = run_bench( "counting", [&]() { bench_do_not_optimize( ++calls ); } );
+   CHECK_EQUAL( r.name, "counting" )
+   CHECK_EQUAL( r.samples, 7 )
+   CHECK_EQUAL( r.iterations > 0, true )
+   CHECK_EQUAL( r.median_ps <= r.p95_ps, true )
+   CHECK_EQUAL( r.p95_ps <= r.p99_ps, true )
+   CHECK_EQUAL( calls >= (7 + 2) * r.iterations, true )
+
+   // one iteration per sample, the leaked pages show up as heap growth
+   bench_settings() = bench_config{ 0, 3, 0, false };
+   const bench_result leak = run_bench( "leak", []() { bench_do_not_optimize( malloc( 64 * 1024 ) ); } );
+   CHECK_EQUAL( leak.iterations, 1 )
+   CHECK_EQUAL( leak.heap_pages > 0, true )
+   CHECK_EQUAL( leak.heap_bytes > 0, true )
+
+   //// std::string bench_fixed(uint64_t, uint64_t)
+   CHECK_EQUAL( bench_fixed( 12345, 1000 ), "12.34" )
+   CHECK_EQUAL( bench_fixed( 7, 1000 ), "0.00" )
+   CHECK_EQUAL( bench_fixed( 50, 1000 ), "0.05" )
+   CHECK_EQUAL( bench_fixed( 3, 2 ), "1.50" )
+
+   //// void print_bench_result(const bench_result&)
+   bench_result printed;
+   printed.name       = "printed";
+   printed.median_ps  = 1500;
+   printed.p95_ps     = 2000;
+   printed.p99_ps     = 2250;
+   printed.heap_bytes = 64;
+   printed.samples    = 2;
+   printed.iterations = 16;
+   bench_settings().json = true;
+   CHECK_PRINT( "{\"name\":\"printed\",\"median_ns\":1.50,\"p95_ns\":2.00,\"p99_ns\":2.25,\"heap_bytes_per_op\":2.00,"
+                "\"heap_pages\":0,\"samples\":2,\"iterations\":16}\n", [&]() { print_bench_result( printed ); } )
+
+   bench_settings() = saved;
+   silence_output(false);
+EOSIO_TEST_END
+
+EOSIO_BENCH_BEGIN(pack_unpack_bench)
+   static const vector<string> value{ "alice", "bob", "carol", "dan" };
+   bench_do_not_optimize( unpack<vector<string>>( pack( value ) ) );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(name_to_string_bench)
+   static const name value{ "eosio.token" };
+   bench_do_not_optimize( value.to_string() );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(name_from_string_bench)
+   static const string value{ "eosio.token" };
+   bench_do_not_optimize( name{ value } );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(asset_to_string_bench)
+   static const asset value{ 123456789, symbol{ "SYS", 4 } };
+   bench_do_not_optimize( value.to_string() );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(multi_index_emplace_erase_bench)
+   static bench_table table( "code"_n, "scope"_n.value );
+   static uint64_t next_id = 0;
+   const auto it = table.emplace( "code"_n, [&]( auto& row ) {
+      row.id    = next_id++;
+      row.owner = name{ row.id };
+      row.memo  = "memo";
+   });
+   table.erase( it );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(multi_index_find_bench)
+   static bench_table table( "code"_n, "finds"_n.value );
+   static const bool filled = [] {
+      for ( uint64_t id = 0; id < 1000; id++ )
+         table.emplace( "code"_n, [&]( auto& row ) { row.id = id; row.owner = name{ id }; } );
+      return true;
+   }();
+   static uint64_t id = 0;
+   bench_do_not_optimize( table.find( id++ % 1000 )->owner );
+   bench_do_not_optimize( filled );
+EOSIO_BENCH_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(bench_runner_test);
+
+   bench_parse_args(argc, argv);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+   EOSIO_BENCH(pack_unpack_bench);
+   EOSIO_BENCH(name_to_string_bench);
+   EOSIO_BENCH(name_from_string_bench);
+   EOSIO_BENCH(asset_to_string_bench);
+   EOSIO_BENCH(multi_index_emplace_erase_bench);
+   EOSIO_BENCH(multi_index_find_bench);
+   return has_failed();
+}
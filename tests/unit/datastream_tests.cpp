@@ -8,14 +8,17 @@
 #include <list>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <eosio/tester.hpp>
+#include <eosio/asset.hpp>
 #include <eosio/binary_extension.hpp>
 #include <eosio/crypto.hpp>
 #include <eosio/datastream.hpp>
 #include <eosio/ignore.hpp>
 #include <eosio/symbol.hpp>
+#include <eosio/time.hpp>
 
 using std::array;
 using std::begin;
@@ -23,26 +26,38 @@ using std::deque;
 using std::end;
 using std::fill;
 using std::list;
+using std::make_tuple;
 using std::map;
 using std::optional;
 using std::pair;
 using std::set;
 using std::string;
+using std::string_view;
 using std::tuple;
 using std::variant;
 using std::vector;
 
+using eosio::asset;
 using eosio::binary_extension;
 using eosio::datastream;
+using eosio::checksum256;
 using eosio::fixed_bytes;
+using eosio::fixed_pack_size_v;
+using eosio::growable_buffer;
+using eosio::has_fixed_pack_size_v;
 using eosio::ignore;
 using eosio::ignore_wrapper;
+using eosio::is_memcpy_serializable_v;
+using eosio::name;
 using eosio::pack;
 using eosio::pack_size;
 using eosio::public_key;
 using eosio::signature;
 using eosio::symbol;
 using eosio::symbol_code;
+using eosio::time_point_sec;
+using eosio::unchecked_region;
+using eosio::unsigned_int;
 using eosio::unpack;
 
 // This data structure (which cannot be defined within a test macro block) needs both a default and a
@@ -54,6 +69,67 @@ struct be_test {
    EOSLIB_SERIALIZE( be_test, (val) )
 };
 
+// Rows for the `fixed_pack_size` tests
+struct fixed_row {
+   name                 owner;
+   asset                balance;
+   array<uint32_t, 3>   counters;
+   checksum256          hash;
+   time_point_sec       updated;
+   bool                 active;
+
+   EOSLIB_SERIALIZE( fixed_row, (owner)(balance)(counters)(hash)(updated)(active) )
+};
+
+// serialized by reflection, fixed size fields do not make it fixed size without EOSLIB_SERIALIZE
+struct reflected_row {
+   name     owner;
+   uint64_t amount;
+};
+
+struct variable_row {
+   name   owner;
+   string memo;
+};
+
+// a fixed size prefix followed by variable fields
+struct prefixed_row {
+   uint64_t         id;
+   asset            balance;
+   bool             active;
+   string           memo;
+   vector<uint64_t> refs;
+};
+
+// an aggregate whose hand written serialization does not match its layout
+struct compact_row {
+   uint64_t value;
+
+   template<typename DataStream>
+   friend DataStream& operator<<( DataStream& ds, const compact_row& r ) { return ds << unsigned_int( uint32_t(r.value) ); }
+   template<typename DataStream>
+   friend DataStream& operator>>( DataStream& ds, compact_row& r ) { unsigned_int v; ds >> v; r.value = v; return ds; }
+};
+
+// the same with operators taking a datastream of any stream
+struct stream_row {
+   uint64_t id;
+   uint64_t amount;
+
+   template<typename Stream>
+   friend datastream<Stream>& operator<<( datastream<Stream>& ds, const stream_row& r ) {
+      return ds << unsigned_int( uint32_t(r.id) ) << unsigned_int( uint32_t(r.amount) );
+   }
+   template<typename Stream>
+   friend datastream<Stream>& operator>>( datastream<Stream>& ds, stream_row& r ) {
+      unsigned_int id, amount;
+      ds >> id >> amount;
+      r.id     = id;
+      r.amount = amount;
+      return ds;
+   }
+};
+
 // Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
 EOSIO_TEST_BEGIN(datastream_test)
    silence_output(true);
@@ -221,6 +297,59 @@ EOSIO_TEST_BEGIN(datastream_specialization_test)
    silence_output(false);
 EOSIO_TEST_END
 
+// Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
+EOSIO_TEST_BEGIN(datastream_growable_test)
+   silence_output(true);
+
+   /// datastream(growable_buffer&, size_t)
+   growable_buffer buffer{'x'};
+   datastream<growable_buffer> ds{buffer, 16};
+   CHECK_EQUAL( ds.tellp(), 0 )
+   CHECK_EQUAL( buffer.capacity() >= 17, true )
+
+   // inline bool write(const char*,size_t)
+   // inline bool put(char)
+   CHECK_EQUAL( ds.write("abc", 3), true )
+   CHECK_EQUAL( ds.put('d'), true )
+   CHECK_EQUAL( ds.tellp(), 4 )
+   CHECK_EQUAL( (buffer == vector<char>{'x','a','b','c','d'}), true )
+
+   // grows past the reserved capacity
+   for ( int i = 0; i < 1000; ++i )
+      ds.put( char(i) );
+   CHECK_EQUAL( ds.tellp(), 1004 )
+   CHECK_EQUAL( buffer.size(), 1005 )
+   CHECK_EQUAL( buffer[1004], char(999) )
+
+   // inline bool seekp(size_t)
+   // inline size_t remaining()const
+   ds.seekp(2);
+   CHECK_EQUAL( ds.remaining(), 1002 )
+   CHECK_EQUAL( ds.write("BC", 2), true )
+   CHECK_EQUAL( buffer[4], 'C' )
+   CHECK_EQUAL( buffer.size(), 1005 )
+
+   // overwrites the tail and appends the rest
+   ds.seekp(1003);
+   CHECK_EQUAL( ds.write("1234", 4), true )
+   CHECK_EQUAL( buffer.size(), 1008 )
+   CHECK_EQUAL( buffer[1007], '4' )
+
+   // inline bool skip(size_t)
+   CHECK_EQUAL( ds.skip(2), true )
+   CHECK_EQUAL( buffer.size(), 1010 )
+   CHECK_EQUAL( ds.tellp(), 1009 )
+
+   // pack() produces the same bytes as a sized datastream
+   const tuple<string, vector<uint64_t>, optional<int>> value{"growable", {1,2,3}, 7};
+   vector<char> sized( pack_size(value) );
+   datastream<char*> sized_ds{sized.data(), sized.size()};
+   sized_ds << value;
+   CHECK_EQUAL( pack(value), sized )
+
+   silence_output(false);
+EOSIO_TEST_END
+
 // Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
 EOSIO_TEST_BEGIN(datastream_stream_test)
    silence_output(true);
@@ -608,10 +737,258 @@ EOSIO_TEST_BEGIN(misc_datastream_test)
    silence_output(false);
 EOSIO_TEST_END
 
+// Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
+EOSIO_TEST_BEGIN(fixed_pack_size_test)
+   silence_output(true);
+
+   static_assert( fixed_pack_size_v<uint32_t> == 4 );
+   static_assert( fixed_pack_size_v<bool> == 1 );
+   static_assert( fixed_pack_size_v<name> == 8 );
+   static_assert( fixed_pack_size_v<asset> == 16 );
+   static_assert( fixed_pack_size_v<checksum256> == 32 );
+   static_assert( fixed_pack_size_v<uint64_t[2]> == 1 + 16 );
+   static_assert( fixed_pack_size_v<pair<name, bool>> == 9 );
+   static_assert( fixed_pack_size_v<tuple<uint8_t, asset, checksum256>> == 49 );
+   static_assert( fixed_pack_size_v<fixed_row> == 8 + 16 + 12 + 32 + 4 + 1 );
+   static_assert( eosio::pack_size( pair<name, bool>{} ) == 9 );
+
+   CHECK_EQUAL( has_fixed_pack_size_v<string>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<vector<uint64_t>>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<optional<uint64_t>>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<unsigned_int>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<variable_row>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<compact_row>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<stream_row>, false )
+   CHECK_EQUAL( has_fixed_pack_size_v<reflected_row>, false )
+   CHECK_EQUAL( (has_fixed_pack_size_v<pair<name, string>>), false )
+
+   // the fixed size path packs the same bytes as the checked datastream
+   fixed_row row{ name{"alice"}, asset{5, symbol{"SYS", 4}}, {1, 2, 3}, checksum256{}, time_point_sec{42}, true };
+   row.hash = checksum256{array<uint8_t, 32>{1, 2, 3, 4, 5, 6, 7, 8, 9}};
+   char expected[128];
+   datastream<char*> ds{expected, sizeof(expected)};
+   ds << row;
+   const vector<char> packed = pack( row );
+   CHECK_EQUAL( packed.size(), fixed_pack_size_v<fixed_row> )
+   CHECK_EQUAL( ds.tellp(), packed.size() )
+   CHECK_EQUAL( memcmp( expected, packed.data(), packed.size() ), 0 )
+
+   const fixed_row unpacked = unpack<fixed_row>( packed );
+   CHECK_EQUAL( unpacked.owner, row.owner )
+   CHECK_EQUAL( unpacked.balance, row.balance )
+   CHECK_EQUAL( unpacked.counters, row.counters )
+   CHECK_EQUAL( unpacked.hash, row.hash )
+   CHECK_EQUAL( unpacked.updated == row.updated, true )
+   CHECK_EQUAL( unpacked.active, row.active )
+
+   // a single upfront check guards the unchecked decoding
+   CHECK_ASSERT( "read", [&](){ unpack<fixed_row>( packed.data(), packed.size() - 1 ); } )
+
+   CHECK_EQUAL( pack( compact_row{300} ).size(), 2 )
+
+   // packed and unpacked through their own operators, not the sizes of their fields
+   const vector<char> streamed = pack( pair<stream_row, name>{ stream_row{300, 5}, name{"bob"} } );
+   CHECK_EQUAL( streamed.size(), 2 + 1 + 8 )
+   const auto unstreamed = unpack<pair<stream_row, name>>( streamed );
+   CHECK_EQUAL( unstreamed.first.id, 300 )
+   CHECK_EQUAL( unstreamed.first.amount, 5 )
+   CHECK_EQUAL( unstreamed.second, name{"bob"} )
+   CHECK_ASSERT( "read", [&](){ unpack<pair<stream_row, name>>( streamed.data(), streamed.size() - 1 ); } )
+   CHECK_EQUAL( pack( reflected_row{ name{"bob"}, 5 } ).size(), 16 )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Packs each element on its own, the reference for the bulk paths
+template <typename Container>
+static vector<char> pack_elementwise( const Container& c, bool with_size ) {
+   vector<char> result;
+   if ( with_size )
+      result = pack( unsigned_int(c.size()) );
+   for ( const auto& elem : c ) {
+      const auto bytes = pack( elem );
+      result.insert( result.end(), bytes.begin(), bytes.end() );
+   }
+   return result;
+}
+
+// Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
+EOSIO_TEST_BEGIN(memcpy_serializable_test)
+   silence_output(true);
+
+   CHECK_EQUAL( is_memcpy_serializable_v<uint64_t>, true )
+   CHECK_EQUAL( is_memcpy_serializable_v<name>, true )
+   CHECK_EQUAL( is_memcpy_serializable_v<asset>, true )
+   CHECK_EQUAL( is_memcpy_serializable_v<bool>, false )
+   CHECK_EQUAL( is_memcpy_serializable_v<string>, false )
+   CHECK_EQUAL( is_memcpy_serializable_v<eosio::checksum256>, false )
+
+   // --------------------
+   // std::vector<uint64_t>
+   vector<uint64_t> u64s;
+   for ( uint64_t i = 0; i < 1000; ++i )
+      u64s.push_back( i * 0x0123456789ABCDEFull );
+   CHECK_EQUAL( pack(u64s), pack_elementwise(u64s, true) )
+   CHECK_EQUAL( unpack<vector<uint64_t>>(pack(u64s)), u64s )
+   CHECK_EQUAL( pack_size(u64s), 2 + 1000 * sizeof(uint64_t) )
+
+   // -----------------
+   // std::vector<name>
+   const vector<name> names{name{"alice"}, name{"bob"}, name{"eosio.token"}};
+   CHECK_EQUAL( pack(names), pack_elementwise(names, true) )
+   CHECK_EQUAL( unpack<vector<name>>(pack(names)), names )
+
+   // ---------------------------
+   // std::vector<time_point_sec>
+   const vector<time_point_sec> times{time_point_sec{1}, time_point_sec{0xFFFFFFFF}};
+   CHECK_EQUAL( pack(times), pack_elementwise(times, true) )
+   CHECK_EQUAL( unpack<vector<time_point_sec>>(pack(times)) == times, true )
+
+   // -----------------------
+   // std::array<asset, N>
+   const array<asset, 2> assets{asset{-42, symbol{"SYS", 4}}, asset{7, symbol{"WAX", 8}}};
+   CHECK_EQUAL( pack(assets), pack_elementwise(assets, false) )
+   CHECK_EQUAL( (unpack<array<asset, 2>>(pack(assets)) == assets), true )
+
+   // ---------
+   // name[N]
+   const name cnames[2]{name{"carol"}, name{"dave"}};
+   name rnames[2];
+   char buffer[32];
+   datastream<char*> ds{buffer, sizeof(buffer)};
+   ds << cnames;
+   CHECK_EQUAL( ds.tellp(), 1 + sizeof(cnames) )
+   ds.seekp(0);
+   ds >> rnames;
+   CHECK_EQUAL( rnames[0] == cnames[0] && rnames[1] == cnames[1], true )
+
+   // a length larger than the payload is rejected before allocating
+   vector<char> truncated = pack( unsigned_int(1000) );
+   truncated.resize( truncated.size() + 8 );
+   CHECK_ASSERT( "read", [&](){ unpack<vector<uint64_t>>(truncated); } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
+EOSIO_TEST_BEGIN(unchecked_region_test)
+   silence_output(true);
+
+   char buffer[64]{};
+   const uint64_t values[2]{0x0102030405060708ull, 42};
+
+   // reserve_checked(size_t, const char*)
+   datastream<char*> ds{buffer, sizeof(buffer)};
+   ds.reserve_checked( sizeof(buffer) );
+   CHECK_ASSERT( "read", [&](){ ds.reserve_checked( sizeof(buffer) + 1 ); } )
+   CHECK_ASSERT( "write", [&](){ ds.reserve_checked( sizeof(buffer) + 1, "write" ); } )
+
+   // unchecked_region(datastream<T>&, size_t, const char*)
+   {
+      unchecked_region region{ds, sizeof(values), "write"};
+      region.stream() << values[0] << values[1];
+      CHECK_EQUAL( ds.tellp(), 0 )
+   }
+   CHECK_EQUAL( ds.tellp(), sizeof(values) )
+   CHECK_EQUAL( memcmp( buffer, values, sizeof(values) ), 0 )
+
+   datastream<const char*> rds{buffer, sizeof(values)};
+   uint64_t read_values[2]{};
+   {
+      unchecked_region region{rds, sizeof(values)};
+      region.stream() >> read_values[0] >> read_values[1];
+   }
+   CHECK_EQUAL( rds.remaining(), 0 )
+   CHECK_EQUAL( read_values[0], values[0] )
+   CHECK_EQUAL( read_values[1], values[1] )
+
+   rds.seekp( 1 );
+   CHECK_ASSERT( "read", ([&](){ unchecked_region region{rds, sizeof(values)}; }) )
+
+   // structs with a fixed size prefix
+   const prefixed_row row{ 7, asset{5, symbol{"SYS", 4}}, true, "memo", {1, 2, 3} };
+   const vector<char> packed = pack( row );
+   CHECK_EQUAL( packed.size(), 8 + 16 + 1 + 5 + 1 + 3*8 )
+   CHECK_EQUAL( pack_size( row ), packed.size() )
+   vector<char> expected = pack( make_tuple( row.id, row.balance, row.active ) );
+   const vector<char> rest = pack( make_tuple( row.memo, row.refs ) );
+   expected.insert( expected.end(), rest.begin(), rest.end() );
+   CHECK_EQUAL( packed, expected )
+   CHECK_EQUAL( (unpack<tuple<uint64_t, asset, bool, string>>( packed ) == make_tuple( row.id, row.balance, row.active, row.memo )), true )
+
+   const prefixed_row unpacked = unpack<prefixed_row>( packed );
+   CHECK_EQUAL( unpacked.id, row.id )
+   CHECK_EQUAL( unpacked.balance, row.balance )
+   CHECK_EQUAL( unpacked.active, row.active )
+   CHECK_EQUAL( unpacked.memo, row.memo )
+   CHECK_EQUAL( unpacked.refs, row.refs )
+
+   // truncated in the prefix and in the variable part
+   CHECK_ASSERT( "read", ([&](){ unpack<prefixed_row>( packed.data(), 20 ); }) )
+   CHECK_ASSERT( "read", ([&](){ unpack<prefixed_row>( packed.data(), packed.size() - 1 ); }) )
+   CHECK_ASSERT( "write", ([&](){ datastream<char*> small{buffer, 20}; small << row; }) )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosio/datastream.hpp`
+EOSIO_TEST_BEGIN(string_view_test)
+   silence_output(true);
+
+   //// DataStream& operator<<(DataStream&, const std::basic_string_view<char, Traits>&)
+   // packed the same as std::string
+   const string memo{"a memo that stays in the action data"};
+   const vector<char> packed = pack( memo );
+   CHECK_EQUAL( pack( string_view{memo} ), packed )
+   CHECK_EQUAL( pack_size( string_view{memo} ), packed.size() )
+   CHECK_EQUAL( pack( string_view{} ), pack( string{} ) )
+
+   //// datastream<const char*>& operator>>(datastream<const char*>&, std::string_view&)
+   datastream<const char*> ds{packed.data(), packed.size()};
+   string_view view;
+   ds >> view;
+   CHECK_EQUAL( string{view}, memo )
+   CHECK_EQUAL( view.data(), packed.data() + 1 )
+   CHECK_EQUAL( ds.remaining(), 0 )
+
+   // the generated action dispatchers read every argument through one tuple of references
+   const vector<char> args = pack( make_tuple( name{"alice"}, asset{5, symbol{"SYS", 4}}, memo, vector<uint64_t>{1, 2} ) );
+   name to;
+   asset quantity;
+   string_view args_memo;
+   vector<uint64_t> refs;
+   datastream<const char*> args_ds{args.data(), args.size()};
+   auto tied = std::tie( to, quantity, args_memo, refs );
+   args_ds >> tied;
+   CHECK_EQUAL( to, name{"alice"} )
+   CHECK_EQUAL( quantity, (asset{5, symbol{"SYS", 4}}) )
+   CHECK_EQUAL( string{args_memo}, memo )
+   CHECK_EQUAL( args_memo.data(), args.data() + 8 + 16 + 1 )
+   CHECK_EQUAL( refs.size(), 2 )
+
+   // a length past the end of the buffer is rejected
+   CHECK_ASSERT( "read", ([&](){ datastream<const char*> short_ds{packed.data(), packed.size() - 1}; short_ds >> view; }) )
+
+   //// DataStream& operator>>(DataStream&, std::string&)
+   // a corrupt length is rejected before the string is resized
+   const char corrupt[] = { '\xff', '\xff', '\xff', '\xff', 0x0f, 'a', 'b' };
+   string corrupt_memo;
+   CHECK_ASSERT( "read", ([&](){ datastream<const char*> corrupt_ds{corrupt, sizeof(corrupt)}; corrupt_ds >> corrupt_memo; }) )
+   CHECK_EQUAL( corrupt_memo.capacity() < 1024, true )
+   CHECK_ASSERT( "read", ([&](){ datastream<const char*> short_ds{packed.data(), packed.size() - 1}; short_ds >> corrupt_memo; }) )
+
+   silence_output(false);
+EOSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    EOSIO_TEST(datastream_test);
    EOSIO_TEST(datastream_specialization_test);
+   EOSIO_TEST(datastream_growable_test);
    EOSIO_TEST(datastream_stream_test);
    EOSIO_TEST(misc_datastream_test);
+   EOSIO_TEST(memcpy_serializable_test);
+   EOSIO_TEST(fixed_pack_size_test);
+   EOSIO_TEST(unchecked_region_test);
+   EOSIO_TEST(string_view_test);
    return has_failed();
 }
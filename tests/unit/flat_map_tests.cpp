@@ -0,0 +1,132 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/flat_map.hpp>
+#include <eosio/flat_set.hpp>
+#include <eosio/name.hpp>
+
+using std::map;
+using std::pair;
+using std::set;
+using std::string;
+using std::vector;
+
+using eosio::flat_map;
+using eosio::flat_set;
+using eosio::name;
+using eosio::pack;
+using eosio::unpack;
+
+// Definitions in `eosio.cdt/libraries/eosio/flat_set.hpp`
+EOSIO_TEST_BEGIN(flat_set_test)
+   silence_output(true);
+
+   //// flat_set(std::initializer_list<T>)
+   flat_set<uint64_t> fs{5, 1, 3, 1};
+   CHECK_EQUAL( fs.size(), 3 )
+   CHECK_EQUAL( (fs.values() == vector<uint64_t>{1, 3, 5}), true )
+
+   //// std::pair<iterator, bool> insert(const T&)
+   CHECK_EQUAL( fs.insert(4).second, true )
+   CHECK_EQUAL( fs.insert(4).second, false )
+   CHECK_EQUAL( *fs.insert(0).first, 0 )
+   CHECK_EQUAL( (fs.values() == vector<uint64_t>{0, 1, 3, 4, 5}), true )
+
+   //// const_iterator find(const T&)const
+   //// bool contains(const T&)const
+   CHECK_EQUAL( *fs.find(3), 3 )
+   CHECK_EQUAL( fs.find(2) == fs.end(), true )
+   CHECK_EQUAL( fs.contains(5), true )
+   CHECK_EQUAL( fs.count(6), 0 )
+   CHECK_EQUAL( *fs.lower_bound(2), 3 )
+   CHECK_EQUAL( *fs.upper_bound(3), 4 )
+
+   //// size_type erase(const T&)
+   CHECK_EQUAL( fs.erase(0), 1 )
+   CHECK_EQUAL( fs.erase(0), 0 )
+
+   //// operator<<(DataStream&, const flat_set&)
+   //// operator>>(DataStream&, flat_set&)
+   const set<uint64_t> ss{1, 3, 4, 5};
+   CHECK_EQUAL( pack(fs), pack(ss) )
+   CHECK_EQUAL( unpack<flat_set<uint64_t>>( pack(ss) ) == fs, true )
+
+   const set<string> strs{"carol", "alice", "bob"};
+   const auto fstrs = unpack<flat_set<string>>( pack(strs) );
+   CHECK_EQUAL( pack(fstrs), pack(strs) )
+   CHECK_EQUAL( *fstrs.begin(), "alice" )
+
+   // unsorted encodings end up as std::set would have them
+   const vector<name> unsorted{name{"dan"}, name{"alice"}, name{"dan"}, name{"bob"}};
+   CHECK_EQUAL( pack( unpack<flat_set<name>>( pack(unsorted) ) ), pack( unpack<set<name>>( pack(unsorted) ) ) )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosio/flat_map.hpp`
+EOSIO_TEST_BEGIN(flat_map_test)
+   silence_output(true);
+
+   //// flat_map(std::initializer_list<value_type>)
+   flat_map<name, uint64_t> fm{ {name{"bob"}, 2}, {name{"alice"}, 1} };
+   CHECK_EQUAL( fm.size(), 2 )
+   CHECK_EQUAL( fm.begin()->first, name{"alice"} )
+
+   //// V& operator[](const K&)
+   //// V& at(const K&)
+   fm[name{"carol"}] = 3;
+   fm[name{"alice"}] += 10;
+   CHECK_EQUAL( fm.at(name{"alice"}), 11 )
+   CHECK_EQUAL( fm.at(name{"carol"}), 3 )
+   CHECK_ASSERT( "key not found in flat_map", [&](){ fm.at(name{"dan"}); } )
+
+   //// std::pair<iterator, bool> try_emplace(const K&, Args&&...)
+   //// std::pair<iterator, bool> insert(const value_type&)
+   //// std::pair<iterator, bool> insert_or_assign(const K&, M&&)
+   CHECK_EQUAL( fm.try_emplace(name{"bob"}, 20).second, false )
+   CHECK_EQUAL( fm.at(name{"bob"}), 2 )
+   CHECK_EQUAL( fm.insert({name{"dan"}, 4}).second, true )
+   CHECK_EQUAL( fm.insert_or_assign(name{"bob"}, 20).second, false )
+   CHECK_EQUAL( fm.at(name{"bob"}), 20 )
+
+   //// iterator find(const K&)
+   //// size_type erase(const K&)
+   CHECK_EQUAL( fm.find(name{"carol"})->second, 3 )
+   CHECK_EQUAL( fm.find(name{"eve"}) == fm.end(), true )
+   CHECK_EQUAL( fm.erase(name{"dan"}), 1 )
+   CHECK_EQUAL( fm.contains(name{"dan"}), false )
+
+   //// operator<<(DataStream&, const flat_map&)
+   //// operator>>(DataStream&, flat_map&)
+   const map<name, uint64_t> sm{ {name{"alice"}, 11}, {name{"bob"}, 20}, {name{"carol"}, 3} };
+   CHECK_EQUAL( pack(fm), pack(sm) )
+   CHECK_EQUAL( (unpack<flat_map<name, uint64_t>>( pack(sm) ) == fm), true )
+
+   const map<uint64_t, vector<string>> nested{ {7, {"a", "b"}}, {2, {}}, {1000, {"c"}} };
+   const auto fnested = unpack<flat_map<uint64_t, vector<string>>>( pack(nested) );
+   CHECK_EQUAL( pack(fnested), pack(nested) )
+   CHECK_EQUAL( fnested.at(7).size(), 2 )
+
+   // duplicate keys keep their first value, as std::map does
+   const vector<pair<uint64_t, uint64_t>> unsorted{ {3, 1}, {1, 2}, {3, 3}, {2, 4} };
+   const auto fdup = unpack<flat_map<uint64_t, uint64_t>>( pack(unsorted) );
+   CHECK_EQUAL( pack(fdup), (pack( unpack<map<uint64_t, uint64_t>>( pack(unsorted) ) )) )
+   CHECK_EQUAL( fdup.at(3), 1 )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(flat_set_test);
+   EOSIO_TEST(flat_map_test);
+   return has_failed();
+}
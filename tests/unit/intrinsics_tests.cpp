@@ -0,0 +1,186 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <string>
+
+#include <eosio/tester.hpp>
+#include <eosio/action.h>
+#include <eosio/print.h>
+#include <eosio/transaction.h>
+#include <eosio/db.h>
+#include <eosio/memory_db.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+
+using std::string;
+
+using eosio::multi_index;
+using eosio::name;
+using eosio::native::intrinsic_cost;
+using eosio::native::intrinsics;
+using eosio::native::memory_db;
+
+struct counted_row {
+   uint64_t id;
+   string   memo;
+
+   uint64_t primary_key()const { return id; }
+
+   EOSLIB_SERIALIZE( counted_row, (id)(memo) )
+};
+
+using counted_table = multi_index<"counted"_n, counted_row>;
+
+// Definitions in `eosio.cdt/libraries/native/native/eosio/intrinsics.hpp`
+EOSIO_TEST_BEGIN(intrinsic_counters_test)
+   silence_output(true);
+   intrinsics::set_intrinsic<intrinsics::read_action_data>([](void* msg, uint32_t len) { return len; });
+   intrinsics::set_intrinsic<intrinsics::action_data_size>([]() { return 16u; });
+   char buffer[16] = "0123456789abcde";
+
+   //// static void count_calls(bool)
+   //// static const intrinsic_counter& get_counter(intrinsic_name)
+   intrinsics::reset_counters();
+   read_action_data( buffer, sizeof(buffer) );
+   CHECK_EQUAL( intrinsics::counting_calls(), false )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::read_action_data).calls, 0 )
+
+   intrinsics::count_calls(true);
+   read_action_data( buffer, sizeof(buffer) );
+   read_action_data( buffer, 4 );
+   action_data_size();
+   intrinsics::count_calls(false);
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::read_action_data).calls, 2 )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::read_action_data).bytes, 20 )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::action_data_size).calls, 1 )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::action_data_size).bytes, 0 )
+
+   // only the void and char buffers count, not the keys passed by pointer
+   intrinsics::count_calls(true);
+   prints_l( buffer, 10 );
+   uint64_t secondary = 0;
+   db_idx64_find_primary( "code"_n.value, 0, "table"_n.value, &secondary, 1000 );
+   intrinsics::count_calls(false);
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::prints_l).bytes, 10 )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::db_idx64_find_primary).calls, 1 )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::db_idx64_find_primary).bytes, 0 )
+
+   //// static void set_cost(intrinsic_name, intrinsic_cost)
+   //// static uint64_t cost_of(intrinsic_name)
+   CHECK_EQUAL( intrinsics::cost_of(intrinsics::read_action_data), 0 )
+   intrinsics::set_cost( intrinsics::read_action_data, intrinsic_cost{ 100, 2 } );
+   CHECK_EQUAL( intrinsics::get_cost(intrinsics::read_action_data).per_call, 100 )
+   CHECK_EQUAL( intrinsics::cost_of(intrinsics::read_action_data), 2 * 100 + 20 * 2 )
+
+   //// static void reset_counters()
+   intrinsics::reset_counters();
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::read_action_data).calls, 0 )
+   CHECK_EQUAL( intrinsics::cost_of(intrinsics::read_action_data), 0 )
+
+   //// static const char* name_of(intrinsic_name)
+   CHECK_EQUAL( string(intrinsics::name_of(intrinsics::db_get_i64)), "db_get_i64" )
+   CHECK_EQUAL( string(intrinsics::name_of(intrinsics::get_context_free_data)), "get_context_free_data" )
+
+   intrinsics::set_cost( intrinsics::read_action_data, intrinsic_cost{} );
+   silence_output(false);
+EOSIO_TEST_END
+
+static uint32_t counted_data_size(void* user_data) {
+   return ++*static_cast<uint32_t*>(user_data);
+}
+
+// Definitions in `eosio.cdt/libraries/native/native/eosio/intrinsics.hpp`
+EOSIO_TEST_BEGIN(intrinsic_dispatch_test)
+   silence_output(true);
+
+   //// static void set_intrinsic(F&&)
+   uint32_t size = 7;
+   intrinsics::set_intrinsic<intrinsics::action_data_size>([&]() { return size; });
+   CHECK_EQUAL( action_data_size(), 7 )
+   size = 9;
+   CHECK_EQUAL( action_data_size(), 9 )
+
+   //// static function_type<IN> get_intrinsic()
+   const auto previous = intrinsics::get_intrinsic<intrinsics::action_data_size>();
+   CHECK_EQUAL( previous(), 9 )
+
+   //// static void set_intrinsic(function_ptr, void*)
+   //// static void* get_user_data()
+   uint32_t calls = 0;
+   intrinsics::set_intrinsic<intrinsics::action_data_size>( &counted_data_size, &calls );
+   CHECK_EQUAL( intrinsics::get_user_data<intrinsics::action_data_size>(), &calls )
+   CHECK_EQUAL( action_data_size(), 1 )
+   CHECK_EQUAL( intrinsics::get_intrinsic<intrinsics::action_data_size>()(), 2 )
+   CHECK_EQUAL( calls, 2 )
+
+   // a std::function returned by get_intrinsic can be set back
+   intrinsics::set_intrinsic<intrinsics::action_data_size>( previous );
+   size = 11;
+   CHECK_EQUAL( action_data_size(), 11 )
+   CHECK_EQUAL( calls, 2 )
+
+   // the value returned for an intrinsic returning void is dropped
+   const auto previous_auth = intrinsics::get_intrinsic<intrinsics::require_auth>();
+   capi_name authorized = 0;
+   intrinsics::set_intrinsic<intrinsics::require_auth>([&]( capi_name account ) { authorized = account; return true; });
+   require_auth( "alice"_n.value );
+   CHECK_EQUAL( authorized, "alice"_n.value )
+   intrinsics::set_intrinsic<intrinsics::require_auth>( previous_auth );
+
+   CHECK_ASSERT( "unsupported intrinsic", []() { get_context_free_data( 0, nullptr, 0 ); } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/native/native/eosio/tester.hpp`
+EOSIO_TEST_BEGIN(intrinsic_report_test)
+   silence_output(true);
+   intrinsics::set_intrinsic<intrinsics::read_action_data>([](void* msg, uint32_t len) { return len; });
+   intrinsics::set_intrinsic<intrinsics::action_data_size>([]() { return 16u; });
+   char buffer[16];
+
+   //// void print_intrinsic_report(const char*)
+   CHECK_PRINT( "", [&]() { read_action_data( buffer, 8 ); print_intrinsic_report( "off" ); } )
+
+   intrinsics::set_cost( intrinsics::action_data_size, intrinsic_cost{ 50, 0 } );
+   intrinsics::count_calls(true);
+   CHECK_PRINT(
+      "\033[1;37maction \033[0;37mintrinsics: 4 calls, 24 bytes, cost 50\033[0m\n"
+      "   action_data_size                        1 calls         0 bytes             cost 50\n"
+      "   read_action_data                        3 calls         24 bytes            cost 0\n",
+      [&]() {
+         report_intrinsics( "action", [&]() {
+            action_data_size();
+            for ( int i = 0; i < 3; i++ )
+               read_action_data( buffer, 8 );
+         });
+      })
+   CHECK_EQUAL( intrinsics::counting_calls(), true )
+   CHECK_EQUAL( intrinsics::get_counter(intrinsics::read_action_data).calls, 0 )
+
+   //// void report_intrinsics(const char*, F&&)
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+   counted_table table( "code"_n, "code"_n.value );
+   CHECK_PRINT( [](const string& report) {
+      return report.find( "emplace \033[0;37mintrinsics:" ) != string::npos &&
+             report.find( "   db_store_i64 " ) != string::npos;
+   }, [&]() {
+      report_intrinsics( "emplace", [&]() {
+         table.emplace( "code"_n, [](auto& row) { row.id = 1; row.memo = "memo"; } );
+      });
+   })
+
+   intrinsics::count_calls(false);
+   intrinsics::set_cost( intrinsics::action_data_size, intrinsic_cost{} );
+   silence_output(false);
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(intrinsic_counters_test);
+   EOSIO_TEST(intrinsic_dispatch_test);
+   EOSIO_TEST(intrinsic_report_test);
+   return has_failed();
+}
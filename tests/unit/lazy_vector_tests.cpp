@@ -0,0 +1,164 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/datastream.hpp>
+#include <eosio/lazy_vector.hpp>
+#include <eosio/name.hpp>
+#include <eosio/serialize.hpp>
+
+using std::string;
+using std::tuple;
+using std::vector;
+
+using eosio::asset;
+using eosio::datastream;
+using eosio::lazy_vector;
+using eosio::name;
+using eosio::pack;
+using eosio::pack_size;
+using eosio::symbol;
+using eosio::unpack;
+
+// Entries of a batch action, one with a fixed pack size and one without
+struct transfer_entry {
+   name  to;
+   asset quantity;
+
+   EOSLIB_SERIALIZE( transfer_entry, (to)(quantity) )
+};
+
+struct memo_entry {
+   name   to;
+   string memo;
+
+   EOSLIB_SERIALIZE( memo_entry, (to)(memo) )
+};
+
+static int tracked_constructions = 0;
+
+// Entry whose construction is counted, the end of a sequence of them is found without building any
+struct tracked_entry : memo_entry {
+   tracked_entry() { ++tracked_constructions; }
+
+   vector<string>         tags;
+   vector<transfer_entry> transfers;
+
+   EOSLIB_SERIALIZE_DERIVED( tracked_entry, memo_entry, (tags)(transfers) )
+};
+
+// Definitions in `eosio.cdt/libraries/eosio/lazy_vector.hpp`
+EOSIO_TEST_BEGIN(lazy_vector_test)
+   silence_output(true);
+
+   vector<transfer_entry> transfers;
+   for ( uint64_t i = 0; i < 1000; ++i )
+      transfers.push_back( transfer_entry{ name{i + 1}, asset{int64_t(i), symbol{"SYS", 4}} } );
+
+   //// lazy_vector(const std::vector<T>&)
+   //// size_t size()const
+   const lazy_vector<transfer_entry> built{transfers};
+   CHECK_EQUAL( built.size(), 1000 )
+   CHECK_EQUAL( built.empty(), false )
+   CHECK_EQUAL( lazy_vector<transfer_entry>{}.empty(), true )
+
+   //// operator<<(DataStream&, const lazy_vector&)
+   // serialized the same as std::vector<T>
+   const vector<char> packed = pack( transfers );
+   CHECK_EQUAL( pack( built ), packed )
+   CHECK_EQUAL( pack_size( built ), packed.size() )
+
+   //// operator>>(DataStream&, lazy_vector&)
+   //// const_iterator begin()const
+   //// const_iterator end()const
+   const auto lazy = unpack<lazy_vector<transfer_entry>>( packed );
+   CHECK_EQUAL( lazy.size(), transfers.size() )
+   CHECK_EQUAL( lazy.packed_data().size(), packed.size() - 2 )
+   size_t i = 0;
+   for ( const auto& e : lazy ) {
+      CHECK_EQUAL( e.to, transfers[i].to )
+      CHECK_EQUAL( e.quantity, transfers[i].quantity )
+      ++i;
+   }
+   CHECK_EQUAL( i, transfers.size() )
+
+   // a count larger than the payload is rejected
+   vector<char> truncated = packed;
+   truncated.resize( truncated.size() - 1 );
+   CHECK_ASSERT( "read", [&](){ unpack<lazy_vector<transfer_entry>>( truncated ); } )
+
+   // elements packed to no bytes are still counted by the iterators
+   const auto empties = unpack<lazy_vector<tuple<>>>( pack( vector<tuple<>>( 3 ) ) );
+   CHECK_EQUAL( empties.packed_data().size(), 0 )
+   CHECK_EQUAL( empties.begin() == empties.end(), false )
+   CHECK_EQUAL( std::distance( empties.begin(), empties.end() ), 3 )
+
+   //// void push_back(const T&)
+   //// std::vector<T> to_vector()const
+   const vector<memo_entry> memos{ {name{"alice"}, "first"}, {name{"bob"}, ""}, {name{"carol"}, string(200, 'x')} };
+   lazy_vector<memo_entry> appended;
+   for ( const auto& m : memos )
+      appended.push_back( m );
+   CHECK_EQUAL( pack( appended ), pack( memos ) )
+
+   const auto lazy_memos = unpack<lazy_vector<memo_entry>>( pack( memos ) ).to_vector();
+   CHECK_EQUAL( lazy_memos.size(), memos.size() )
+   for ( size_t j = 0; j < memos.size(); ++j ) {
+      CHECK_EQUAL( lazy_memos[j].to, memos[j].to )
+      CHECK_EQUAL( lazy_memos[j].memo, memos[j].memo )
+   }
+
+   vector<char> truncated_memos = pack( memos );
+   truncated_memos.resize( truncated_memos.size() - 1 );
+   CHECK_ASSERT( "read", [&](){ unpack<lazy_vector<memo_entry>>( truncated_memos ); } )
+
+   // back into a std::vector
+   const auto round_trip = unpack<vector<transfer_entry>>( pack( lazy ) );
+   CHECK_EQUAL( round_trip.size(), transfers.size() )
+   CHECK_EQUAL( round_trip.back().quantity, transfers.back().quantity )
+
+   // elements without a fixed pack size are skipped over, not decoded
+   vector<tracked_entry> tracked( 3 );
+   tracked[0].memo = "tags";
+   tracked[0].tags = { "a", "bc", string(300, 'd') };
+   tracked[1].transfers = { transfers[0], transfers[1] };
+   tracked[2].to = name{"dan"};
+   const vector<char> packed_tracked = pack( tracked );
+   tracked_constructions = 0;
+   const auto lazy_tracked = unpack<lazy_vector<tracked_entry>>( packed_tracked );
+   CHECK_EQUAL( tracked_constructions, 0 )
+   CHECK_EQUAL( lazy_tracked.size(), 3 )
+   CHECK_EQUAL( lazy_tracked.packed_data().size(), packed_tracked.size() - 1 )
+   const auto tracked_round_trip = lazy_tracked.to_vector();
+   CHECK_EQUAL( tracked_round_trip[0].tags.back(), string(300, 'd') )
+   CHECK_EQUAL( tracked_round_trip[1].transfers[1].quantity, transfers[1].quantity )
+   CHECK_EQUAL( tracked_round_trip[2].to, name{"dan"} )
+
+   // lengths cut short fail to read their last byte, the rest fail their bounds check
+   const auto read_error = []( const string& msg ) { return msg == "read" || msg == "get"; };
+   for ( size_t cut = 1; cut < packed_tracked.size(); cut += 7 ) {
+      vector<char> cut_tracked( packed_tracked.begin(), packed_tracked.end() - cut );
+      CHECK_ASSERT( read_error, [&](){ unpack<lazy_vector<tracked_entry>>( cut_tracked ); } )
+   }
+
+   //// void clear()
+   appended.clear();
+   CHECK_EQUAL( appended.size(), 0 )
+   CHECK_EQUAL( appended.begin() == appended.end(), true )
+   CHECK_EQUAL( pack( appended ), pack( vector<memo_entry>{} ) )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(lazy_vector_test);
+   return has_failed();
+}
@@ -0,0 +1,458 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <string>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/action.h>
+#include <eosio/crypto.hpp>
+#include <eosio/db.h>
+#include <eosio/memory_db.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+#include <eosio/singleton.hpp>
+
+using std::string;
+using std::vector;
+
+using eosio::checksum256;
+using eosio::const_mem_fun;
+using eosio::indexed_by;
+using eosio::multi_index;
+using eosio::name;
+using eosio::singleton;
+using eosio::native::memory_db;
+
+struct account_row {
+   uint64_t    id;
+   name        owner;
+   uint128_t   pair_key;
+   checksum256 hash;
+   double      weight;
+   long double precise;
+   string      memo;
+
+   uint64_t    primary_key()const { return id; }
+   uint64_t    by_owner()const { return owner.value; }
+   uint128_t   by_pair()const { return pair_key; }
+   checksum256 by_hash()const { return hash; }
+   double      by_weight()const { return weight; }
+   long double by_precise()const { return precise; }
+
+   EOSLIB_SERIALIZE( account_row, (id)(owner)(pair_key)(hash)(weight)(precise)(memo) )
+};
+
+using accounts = multi_index<"accounts"_n, account_row,
+   indexed_by<"byowner"_n, const_mem_fun<account_row, uint64_t, &account_row::by_owner>>,
+   indexed_by<"bypair"_n, const_mem_fun<account_row, uint128_t, &account_row::by_pair>>,
+   indexed_by<"byhash"_n, const_mem_fun<account_row, checksum256, &account_row::by_hash>>,
+   indexed_by<"byweight"_n, const_mem_fun<account_row, double, &account_row::by_weight>>,
+   indexed_by<"byprecise"_n, const_mem_fun<account_row, long double, &account_row::by_precise>>
+>;
+
+struct config {
+   uint32_t version;
+   string   label;
+
+   EOSLIB_SERIALIZE( config, (version)(label) )
+};
+
+// Definitions in `eosio.cdt/libraries/native/memory_db.cpp`
+EOSIO_TEST_BEGIN(memory_db_primary_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+   CHECK_EQUAL( memory_db::get_receiver(), "code"_n )
+   CHECK_EQUAL( current_receiver(), "code"_n.value )
+
+   const uint64_t code  = "code"_n.value;
+   const uint64_t table = "rows"_n.value;
+   const char     data[] = "0123456789";
+
+   //// int32_t db_end_i64(capi_name, uint64_t, capi_name)
+   //// int32_t db_find_i64(capi_name, uint64_t, capi_name, uint64_t)
+   // tables without rows do not exist
+   CHECK_EQUAL( db_end_i64( code, 1, table ), -1 )
+   CHECK_EQUAL( db_find_i64( code, 1, table, 5 ), -1 )
+
+   //// int32_t db_store_i64(uint64_t, capi_name, capi_name, uint64_t, const void*, uint32_t)
+   const int32_t it5 = db_store_i64( 1, table, code, 5, data, 5 );
+   const int32_t it3 = db_store_i64( 1, table, code, 3, data, 3 );
+   const int32_t it9 = db_store_i64( 1, table, code, 9, data, 9 );
+   CHECK_EQUAL( it5 >= 0 && it3 >= 0 && it9 >= 0, true )
+   CHECK_ASSERT( "could not insert object, most likely a uniqueness constraint was violated",
+      [&]() { db_store_i64( 1, table, code, 5, data, 1 ); } )
+   CHECK_ASSERT( "must specify a valid account to pay for new record", [&]() { db_store_i64( 1, table, 0, 6, data, 1 ); } )
+
+   const int32_t end = db_end_i64( code, 1, table );
+   CHECK_EQUAL( end < -1, true )
+   CHECK_EQUAL( db_find_i64( code, 1, table, 5 ), it5 )
+   CHECK_EQUAL( db_find_i64( code, 1, table, 4 ), end )
+   CHECK_EQUAL( db_find_i64( code, 2, table, 5 ), -1 )
+   CHECK_EQUAL( db_end_i64( code, 2, table ), -1 )
+   CHECK_EQUAL( db_lowerbound_i64( code, 1, table, 4 ), it5 )
+   CHECK_EQUAL( db_lowerbound_i64( code, 1, table, 5 ), it5 )
+   CHECK_EQUAL( db_upperbound_i64( code, 1, table, 5 ), it9 )
+   CHECK_EQUAL( db_upperbound_i64( code, 1, table, 9 ), end )
+
+   //// int32_t db_next_i64(int32_t, uint64_t*)
+   //// int32_t db_previous_i64(int32_t, uint64_t*)
+   uint64_t primary = 0;
+   CHECK_EQUAL( db_next_i64( it3, &primary ), it5 )
+   CHECK_EQUAL( primary, 5 )
+   CHECK_EQUAL( db_next_i64( it9, &primary ), end )
+   CHECK_EQUAL( db_next_i64( end, &primary ), -1 )
+   CHECK_EQUAL( db_previous_i64( end, &primary ), it9 )
+   CHECK_EQUAL( primary, 9 )
+   CHECK_EQUAL( db_previous_i64( it5, &primary ), it3 )
+   CHECK_EQUAL( db_previous_i64( it3, &primary ), -1 )
+   CHECK_ASSERT( "invalid iterator", [&]() { db_next_i64( -1, &primary ); } )
+   CHECK_ASSERT( "not a valid end iterator", [&]() { db_previous_i64( end - 100, &primary ); } )
+
+   //// int32_t db_get_i64(int32_t, const void*, uint32_t)
+   char buffer[16] = {};
+   CHECK_EQUAL( db_get_i64( it9, buffer, 0 ), 9 )
+   CHECK_EQUAL( db_get_i64( it9, buffer, 4 ), 4 )
+   CHECK_EQUAL( string(buffer), "0123" )
+   CHECK_EQUAL( db_get_i64( it9, buffer, sizeof(buffer) ), 9 )
+   CHECK_ASSERT( "dereference of end iterator", [&]() { db_get_i64( end, buffer, 0 ); } )
+   CHECK_ASSERT( "iterator out of range", [&]() { db_get_i64( 1000, buffer, 0 ); } )
+
+   //// void db_update_i64(int32_t, capi_name, const void*, uint32_t)
+   db_update_i64( it5, 0, "abc", 3 );
+   CHECK_EQUAL( db_get_i64( it5, buffer, sizeof(buffer) ), 3 )
+   CHECK_EQUAL( string(buffer, 3), "abc" )
+   memory_db::set_receiver( "other"_n );
+   CHECK_ASSERT( "db access violation", [&]() { db_update_i64( it5, 0, "abc", 3 ); } )
+   CHECK_ASSERT( "db access violation", [&]() { db_remove_i64( it5 ); } )
+   memory_db::set_receiver( "code"_n );
+
+   //// void db_remove_i64(int32_t)
+   db_remove_i64( it5 );
+   CHECK_ASSERT( "dereference of deleted object", [&]() { db_get_i64( it5, buffer, 0 ); } )
+   CHECK_EQUAL( db_find_i64( code, 1, table, 5 ), end )
+   CHECK_EQUAL( db_next_i64( it3, &primary ), it9 )
+   db_remove_i64( it3 );
+   db_remove_i64( it9 );
+   CHECK_EQUAL( db_find_i64( code, 1, table, 9 ), -1 )
+   CHECK_EQUAL( db_previous_i64( end, &primary ), -1 )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/native/memory_db.cpp`
+EOSIO_TEST_BEGIN(memory_db_secondary_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   const uint64_t code  = "code"_n.value;
+   const uint64_t table = "rows"_n.value;
+
+   //// int32_t db_idx64_store(uint64_t, capi_name, capi_name, uint64_t, const uint64_t*)
+   uint64_t secondary = 20;
+   const int32_t it1 = db_idx64_store( 1, table, code, 1, &secondary );
+   secondary = 10;
+   const int32_t it2 = db_idx64_store( 1, table, code, 2, &secondary );
+   const int32_t it3 = db_idx64_store( 1, table, code, 3, &secondary );
+   const int32_t end = db_idx64_end( code, 1, table );
+   CHECK_EQUAL( end < -1, true )
+   CHECK_EQUAL( db_idx64_end( code, 2, table ), -1 )
+
+   //// int32_t db_idx64_find_secondary(capi_name, uint64_t, capi_name, const uint64_t*, uint64_t*)
+   //// int32_t db_idx64_find_primary(capi_name, uint64_t, capi_name, uint64_t*, uint64_t)
+   uint64_t primary = 0;
+   CHECK_EQUAL( db_idx64_find_secondary( code, 1, table, &secondary, &primary ), it2 )
+   CHECK_EQUAL( primary, 2 )
+   secondary = 15;
+   CHECK_EQUAL( db_idx64_find_secondary( code, 1, table, &secondary, &primary ), end )
+   CHECK_EQUAL( db_idx64_find_primary( code, 1, table, &secondary, 1 ), it1 )
+   CHECK_EQUAL( secondary, 20 )
+   CHECK_EQUAL( db_idx64_find_primary( code, 1, table, &secondary, 4 ), end )
+
+   //// int32_t db_idx64_lowerbound(capi_name, uint64_t, capi_name, uint64_t*, uint64_t*)
+   //// int32_t db_idx64_upperbound(capi_name, uint64_t, capi_name, uint64_t*, uint64_t*)
+   // ordered by secondary then primary key, the found secondary key is written back
+   secondary = 11;
+   CHECK_EQUAL( db_idx64_lowerbound( code, 1, table, &secondary, &primary ), it1 )
+   CHECK_EQUAL( secondary, 20 )
+   CHECK_EQUAL( primary, 1 )
+   secondary = 0;
+   CHECK_EQUAL( db_idx64_lowerbound( code, 1, table, &secondary, &primary ), it2 )
+   CHECK_EQUAL( secondary, 10 )
+   CHECK_EQUAL( db_idx64_upperbound( code, 1, table, &secondary, &primary ), it1 )
+   CHECK_EQUAL( db_idx64_upperbound( code, 1, table, &secondary, &primary ), end )
+
+   //// int32_t db_idx64_next(int32_t, uint64_t*)
+   //// int32_t db_idx64_previous(int32_t, uint64_t*)
+   CHECK_EQUAL( db_idx64_next( it2, &primary ), it3 )
+   CHECK_EQUAL( db_idx64_next( it3, &primary ), it1 )
+   CHECK_EQUAL( db_idx64_next( it1, &primary ), end )
+   CHECK_EQUAL( db_idx64_next( end, &primary ), -1 )
+   CHECK_EQUAL( db_idx64_previous( end, &primary ), it1 )
+   CHECK_EQUAL( db_idx64_previous( it2, &primary ), -1 )
+
+   //// void db_idx64_update(int32_t, capi_name, const uint64_t*)
+   //// void db_idx64_remove(int32_t)
+   secondary = 5;
+   db_idx64_update( it1, 0, &secondary );
+   CHECK_EQUAL( db_idx64_previous( it2, &primary ), it1 )
+   CHECK_EQUAL( primary, 1 )
+   db_idx64_remove( it2 );
+   CHECK_EQUAL( db_idx64_next( it1, &primary ), it3 )
+   CHECK_ASSERT( "dereference of deleted object", [&]() { db_idx64_next( it2, &primary ); } )
+
+   //// int32_t db_idx256_store(uint64_t, capi_name, capi_name, uint64_t, const uint128_t*, uint32_t)
+   uint128_t key[2] = {1, 2};
+   CHECK_ASSERT( "invalid size of secondary key array for idx256", [&]() { db_idx256_store( 1, table, code, 1, key, 1 ); } )
+   const int32_t it256 = db_idx256_store( 1, table, code, 1, key, 2 );
+   key[1] = 0;
+   CHECK_EQUAL( db_idx256_lowerbound( code, 1, table, key, 2, &primary ), it256 )
+   CHECK_EQUAL( (key[0] == 1 && key[1] == 2), true )
+
+   //// int32_t db_idx_double_store(uint64_t, capi_name, capi_name, uint64_t, const double*)
+   const double nan = std::numeric_limits<double>::quiet_NaN();
+   CHECK_ASSERT( "NaN is not an allowed value for a secondary key", [&]() { db_idx_double_store( 1, table, code, 1, &nan ); } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// multi_index and singleton over `eosio.cdt/libraries/native/memory_db.cpp`
+EOSIO_TEST_BEGIN(memory_db_multi_index_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   accounts table( "code"_n, "scope"_n.value );
+   for ( uint64_t i = 0; i < 100; ++i ) {
+      table.emplace( "code"_n, [&]( auto& r ) {
+         r.id       = i;
+         r.owner    = name{(i * 7919) % 101 + 1};
+         r.pair_key = (uint128_t(i % 10) << 64) | (100 - i);
+         r.hash     = checksum256{std::array<uint64_t, 4>{i % 3, 0, 0, i}};
+         r.weight   = double(i % 13) - 6.5;
+         r.precise  = (long double)(i) / 3;
+         r.memo     = string( i, 'm' );
+      });
+   }
+
+   //// const_iterator find(uint64_t)const
+   //// const T& get(uint64_t, const char*)const
+   CHECK_EQUAL( table.get( 42 ).memo.size(), 42 )
+   CHECK_EQUAL( table.find( 100 ) == table.end(), true )
+   CHECK_ASSERT( "unable to find key", [&]() { table.get( 100 ); } )
+
+   // primary and every secondary index iterate in order, both ways
+   const auto in_order = [&]( const auto& index, auto key ) {
+      size_t count = 0;
+      bool   sorted = true;
+      for ( auto it = index.begin(), prev = it; it != index.end(); prev = it++, ++count )
+         sorted &= !(key( *it ) < key( *prev ));
+      size_t reverse_count = 0;
+      for ( auto it = index.rbegin(); it != index.rend(); ++it )
+         ++reverse_count;
+      return sorted && count == 100 && reverse_count == 100;
+   };
+   CHECK_EQUAL( in_order( table, []( const auto& r ) { return r.id; } ), true )
+   CHECK_EQUAL( in_order( table.get_index<"byowner"_n>(), []( const auto& r ) { return r.by_owner(); } ), true )
+   CHECK_EQUAL( in_order( table.get_index<"bypair"_n>(), []( const auto& r ) { return r.by_pair(); } ), true )
+   CHECK_EQUAL( in_order( table.get_index<"byhash"_n>(), []( const auto& r ) { return r.by_hash(); } ), true )
+   CHECK_EQUAL( in_order( table.get_index<"byweight"_n>(), []( const auto& r ) { return r.by_weight(); } ), true )
+   CHECK_EQUAL( in_order( table.get_index<"byprecise"_n>(), []( const auto& r ) { return r.by_precise(); } ), true )
+
+   //// const_iterator lower_bound(secondary_key_type)const
+   //// const_iterator upper_bound(secondary_key_type)const
+   const auto& by_pair = table.get_index<"bypair"_n>();
+   CHECK_EQUAL( by_pair.lower_bound( uint128_t(3) << 64 )->id, 93 )
+   CHECK_EQUAL( by_pair.upper_bound( (uint128_t(9) << 64) | 100 ) == by_pair.end(), true )
+   CHECK_EQUAL( table.lower_bound( 50 )->id, 50 )
+   CHECK_EQUAL( table.upper_bound( 99 ) == table.end(), true )
+
+   //// void modify(const_iterator, name, Lambda&&)
+   //// const_iterator erase(const_iterator)
+   const auto& by_weight = table.get_index<"byweight"_n>();
+   table.modify( table.get( 10 ), "code"_n, []( auto& r ) { r.weight = -100; r.memo = "moved"; } );
+   CHECK_EQUAL( by_weight.begin()->id, 10 )
+   CHECK_EQUAL( by_weight.begin()->memo, "moved" )
+   for ( auto it = table.begin(); it != table.end(); ) {
+      if ( it->id % 2 )
+         it = table.erase( it );
+      else
+         ++it;
+   }
+   size_t remaining = 0;
+   for ( auto it = by_weight.begin(); it != by_weight.end(); ++it, ++remaining )
+      CHECK_EQUAL( it->id % 2, 0 )
+   CHECK_EQUAL( remaining, 50 )
+
+   // another receiver can read the table but not write it
+   memory_db::set_receiver( "other"_n );
+   accounts foreign( "code"_n, "scope"_n.value );
+   CHECK_EQUAL( foreign.get( 42 ).memo.size(), 42 )
+   CHECK_ASSERT( "cannot erase objects in table of another contract", [&]() { foreign.erase( foreign.get( 42 ) ); } )
+   memory_db::set_receiver( "code"_n );
+
+   //// singleton
+   singleton<"config"_n, config> cfg( "code"_n, "code"_n.value );
+   CHECK_EQUAL( cfg.exists(), false )
+   cfg.set( config{1, "first"}, "code"_n );
+   CHECK_EQUAL( cfg.get().label, "first" )
+   cfg.set( config{2, "second"}, "code"_n );
+   CHECK_EQUAL( (singleton<"config"_n, config>( "code"_n, "code"_n.value ).get().version), 2 )
+   cfg.remove();
+   CHECK_EQUAL( cfg.exists(), false )
+
+   //// static void clear()
+   memory_db::clear();
+   CHECK_EQUAL( accounts( "code"_n, "scope"_n.value ).begin() == accounts( "code"_n, "scope"_n.value ).end(), true )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+static void set_account( account_row& r, uint64_t id, name owner, const string& memo ) {
+   r = account_row{ id, owner, 0, checksum256{}, 0, 0, memo };
+}
+
+static accounts make_accounts( uint64_t scope ) {
+   accounts table( "code"_n, scope );
+   table.emplace( "code"_n, []( auto& r ) { set_account( r, 1, "alice"_n, "first" ); } );
+   return table;
+}
+
+// deferred writes of multi_index over `eosio.cdt/libraries/native/memory_db.cpp`
+EOSIO_TEST_BEGIN(memory_db_deferred_writes_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   const uint64_t code  = "code"_n.value;
+   const uint64_t scope = "deferred"_n.value;
+   const auto stored_memo = [&]( uint64_t id ) {
+      return accounts( "code"_n, scope ).get( id ).memo;
+   };
+   const auto stored_owner = [&]( uint64_t id ) {
+      uint64_t owner = 0;
+      db_idx64_find_primary( code, scope, "accounts"_n.value & ~uint64_t(0xF), &owner, id ); // first secondary index
+      return owner;
+   };
+
+   accounts writer( "code"_n, scope );
+   for ( uint64_t i = 1; i <= 3; ++i )
+      writer.emplace( "code"_n, [&]( auto& r ) { set_account( r, i, name{i}, "stored" ); } );
+
+   //// void defer_writes(bool)
+   //// void modify(const T&, name, Lambda&&)
+   //// void flush()
+   accounts table( "code"_n, scope );
+   table.defer_writes();
+   CHECK_EQUAL( table.deferred_writes(), true )
+   for ( int i = 0; i < 3; ++i )
+      table.modify( table.get( 1 ), "code"_n, [&]( auto& r ) { r.memo = "pending " + std::to_string(i); r.owner = "bob"_n; } );
+
+   // other instances and db reads see the row as last written until the flush
+   CHECK_EQUAL( table.get( 1 ).memo, "pending 2" )
+   CHECK_EQUAL( table.find_view( 1 ).unpack().memo, "pending 2" )
+   CHECK_EQUAL( stored_memo( 1 ), "stored" )
+   CHECK_EQUAL( stored_owner( 1 ), 1 )
+
+   table.flush();
+   CHECK_EQUAL( stored_memo( 1 ), "pending 2" )
+   CHECK_EQUAL( stored_owner( 1 ), "bob"_n.value )
+
+   // reading a secondary index flushes first, so it never returns stale keys
+   table.modify( table.get( 2 ), "code"_n, []( auto& r ) { r.owner = "carol"_n; } );
+   CHECK_EQUAL( stored_owner( 2 ), 2 )
+   CHECK_EQUAL( table.get_index<"byowner"_n>().find( "carol"_n.value )->id, 2 )
+   CHECK_EQUAL( stored_owner( 2 ), "carol"_n.value )
+
+   // erased rows are not written back
+   table.modify( table.get( 3 ), "code"_n, []( auto& r ) { r.memo = "erased"; } );
+   table.erase( table.get( 3 ) );
+   table.flush();
+   CHECK_EQUAL( accounts( "code"_n, scope ).find( 3 ) == accounts( "code"_n, scope ).end(), true )
+
+   //// void defer_writes(bool)
+   table.modify( table.get( 1 ), "code"_n, []( auto& r ) { r.memo = "disabled"; } );
+   table.defer_writes( false );
+   CHECK_EQUAL( stored_memo( 1 ), "disabled" )
+   table.modify( table.get( 1 ), "code"_n, []( auto& r ) { r.memo = "direct"; } );
+   CHECK_EQUAL( stored_memo( 1 ), "direct" )
+
+   //// ~multi_index()
+   {
+      accounts scoped( "code"_n, scope );
+      scoped.defer_writes();
+      scoped.modify( scoped.get( 2 ), "code"_n, []( auto& r ) { r.memo = "destroyed"; r.owner = "dave"_n; } );
+      CHECK_EQUAL( stored_memo( 2 ), "stored" )
+   }
+   CHECK_EQUAL( stored_memo( 2 ), "destroyed" )
+   CHECK_EQUAL( stored_owner( 2 ), "dave"_n.value )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// multi_index over `eosio.cdt/libraries/native/memory_db.cpp`
+EOSIO_TEST_BEGIN(memory_db_multi_index_move_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   //// multi_index(multi_index&&)
+   accounts returned = make_accounts( "moved"_n.value );
+   const auto& row = returned.get( 1 );
+   returned.modify( row, "code"_n, []( auto& r ) { r.memo = "modified"; } );
+   CHECK_EQUAL( returned.get( 1 ).memo, "modified" )
+
+   // pending rows move with the table and are written once
+   returned.defer_writes();
+   returned.modify( row, "code"_n, []( auto& r ) { r.memo = "pending"; } );
+   {
+      accounts moved( std::move(returned) );
+      CHECK_EQUAL( &moved.get( 1 ), &row )
+      CHECK_EQUAL( moved.deferred_writes(), true )
+      CHECK_EQUAL( accounts( "code"_n, "moved"_n.value ).get( 1 ).memo, "modified" )
+      moved.modify( row, "code"_n, []( auto& r ) { r.memo = "moved"; } );
+      moved.erase( row );
+      moved.emplace( "code"_n, []( auto& r ) { set_account( r, 2, "bob"_n, "moved" ); } );
+      moved.modify( moved.get( 2 ), "code"_n, []( auto& r ) { r.memo = "moved twice"; } );
+   }
+   CHECK_EQUAL( accounts( "code"_n, "moved"_n.value ).find( 1 ) == accounts( "code"_n, "moved"_n.value ).end(), true )
+   CHECK_EQUAL( accounts( "code"_n, "moved"_n.value ).get( 2 ).memo, "moved twice" )
+
+   //// multi_index& operator=(multi_index&&)
+   // the rows pending in the target are written before it is replaced
+   accounts target = make_accounts( "target"_n.value );
+   target.defer_writes();
+   target.modify( target.get( 1 ), "code"_n, []( auto& r ) { r.memo = "replaced"; } );
+   target = make_accounts( "source"_n.value );
+   CHECK_EQUAL( accounts( "code"_n, "target"_n.value ).get( 1 ).memo, "replaced" )
+   CHECK_EQUAL( target.get_scope(), "source"_n.value )
+   CHECK_EQUAL( target.deferred_writes(), false )
+   target.modify( target.get( 1 ), "code"_n, []( auto& r ) { r.memo = "assigned"; } );
+   CHECK_EQUAL( accounts( "code"_n, "source"_n.value ).get( 1 ).memo, "assigned" )
+
+   // the pooled rows of emplace_many are destroyed before their block is released
+   accounts pooled( "code"_n, "pooled"_n.value );
+   pooled.emplace_many( "code"_n, vector<uint64_t>{ 1, 2, 3 }, []( auto& r, uint64_t id ) {
+      set_account( r, id, "carol"_n, string( 64, 'p' ) );
+   } );
+   CHECK_EQUAL( pooled.get( 3 ).memo, string( 64, 'p' ) )
+   pooled = make_accounts( "replacement"_n.value );
+   CHECK_EQUAL( pooled.get( 1 ).memo, "first" )
+   CHECK_EQUAL( pooled.find( 2 ) == pooled.end(), true )
+   CHECK_EQUAL( accounts( "code"_n, "pooled"_n.value ).get( 2 ).owner, "carol"_n )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(memory_db_primary_test);
+   EOSIO_TEST(memory_db_secondary_test);
+   EOSIO_TEST(memory_db_multi_index_test);
+   EOSIO_TEST(memory_db_deferred_writes_test);
+   EOSIO_TEST(memory_db_multi_index_move_test);
+   return has_failed();
+}
@@ -0,0 +1,161 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <eosio/tester.hpp>
+#include <eosio/memory.hpp>
+
+namespace mem = eosio::_memory_detail;
+
+static constexpr size_t buffer_size = 256;
+
+static void byte_copy( uint8_t* dest, const uint8_t* src, size_t n ) {
+   for ( size_t i = 0; i < n; i++ )
+      dest[i] = src[i];
+}
+
+static void byte_fill( uint8_t* dest, uint8_t c, size_t n ) {
+   for ( size_t i = 0; i < n; i++ )
+      dest[i] = c;
+}
+
+static int byte_compare( const uint8_t* p1, const uint8_t* p2, size_t n ) {
+   for ( size_t i = 0; i < n; i++ ) {
+      if ( p1[i] < p2[i] )
+         return -1;
+      else if ( p1[i] > p2[i] )
+         return 1;
+   }
+   return 0;
+}
+
+static void pattern( uint8_t* buf, size_t n, uint8_t seed ) {
+   for ( size_t i = 0; i < n; i++ )
+      buf[i] = uint8_t(i * 31 + seed);
+}
+
+static bool same( const uint8_t* a, const uint8_t* b, size_t n ) {
+   return byte_compare( a, b, n ) == 0;
+}
+
+// Definitions in `eosio.cdt/libraries/eosiolib/core/eosio/memory.hpp`
+EOSIO_TEST_BEGIN(memory_test)
+   silence_output(true);
+
+   alignas(8) uint8_t src[buffer_size];
+   alignas(8) uint8_t dest[buffer_size];
+   alignas(8) uint8_t expected[buffer_size];
+
+   // every length and every source/destination misalignment
+   bool copy_ok = true, fill_ok = true;
+   for ( size_t n = 0; n < 80; ++n ) {
+      for ( size_t so = 0; so < 8; ++so ) {
+         for ( size_t dof = 0; dof < 8; ++dof ) {
+            pattern( src, buffer_size, 1 );
+            pattern( dest, buffer_size, 2 );
+            pattern( expected, buffer_size, 2 );
+            byte_copy( expected + dof, src + so, n );
+            mem::copy_forward( dest + dof, src + so, n );
+            copy_ok &= same( dest, expected, buffer_size );
+
+            pattern( dest, buffer_size, 2 );
+            pattern( expected, buffer_size, 2 );
+            byte_fill( expected + dof, uint8_t(0xA0 + so), n );
+            mem::fill( dest + dof, uint8_t(0xA0 + so), n );
+            fill_ok &= same( dest, expected, buffer_size );
+         }
+      }
+   }
+   CHECK_EQUAL( copy_ok, true )
+   CHECK_EQUAL( fill_ok, true )
+
+   // overlapping moves in both directions
+   bool move_ok = true;
+   for ( size_t n = 0; n < 100; ++n ) {
+      for ( size_t from = 0; from < 20; ++from ) {
+         for ( size_t to = 0; to < 20; ++to ) {
+            pattern( dest, buffer_size, 3 );
+            pattern( expected, buffer_size, 3 );
+            uint8_t tmp[buffer_size];
+            byte_copy( tmp, expected + from, n );
+            byte_copy( expected + to, tmp, n );
+            mem::move( dest + to, dest + from, n );
+            move_ok &= same( dest, expected, buffer_size );
+         }
+      }
+   }
+   CHECK_EQUAL( move_ok, true )
+
+   // the sign of the first difference wins, wherever it is
+   bool compare_ok = true;
+   for ( size_t n = 1; n < 64; ++n ) {
+      for ( size_t at = 0; at < n; ++at ) {
+         pattern( src, buffer_size, 4 );
+         pattern( dest, buffer_size, 4 );
+         compare_ok &= mem::compare( src + 1, dest + 1, n ) == 0;
+         dest[1 + at] = uint8_t(src[1 + at] + 1);
+         if ( at + 1 < n )
+            src[2 + at] = uint8_t(dest[2 + at] + 1);
+         compare_ok &= mem::compare( src + 1, dest + 1, n ) == byte_compare( src + 1, dest + 1, n );
+         compare_ok &= mem::compare( dest + 1, src + 1, n ) == byte_compare( dest + 1, src + 1, n );
+      }
+   }
+   CHECK_EQUAL( compare_ok, true )
+   CHECK_EQUAL( mem::compare( src, dest, 0 ), 0 )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+static constexpr size_t bench_size = 4096;
+
+// The copies read one byte past word alignment, the compares run over equal buffers
+static uint8_t bench_src[bench_size + 8];
+static uint8_t bench_dest[bench_size + 8];
+
+// Byte loops against the word loops.
+// Vectorization is disabled for this file as contracts have no SIMD to fall back on.
+EOSIO_BENCH_BEGIN(memcpy_bytes_bench)
+   byte_copy( bench_dest, bench_src + 1, bench_size );
+   bench_do_not_optimize( bench_dest );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(memcpy_words_bench)
+   mem::copy_forward( bench_dest, bench_src + 1, bench_size );
+   bench_do_not_optimize( bench_dest );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(memset_bytes_bench)
+   static uint8_t c = 0;
+   byte_fill( bench_dest, c++, bench_size );
+   bench_do_not_optimize( bench_dest );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(memset_words_bench)
+   static uint8_t c = 0;
+   mem::fill( bench_dest, c++, bench_size );
+   bench_do_not_optimize( bench_dest );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(memcmp_bytes_bench)
+   bench_do_not_optimize( byte_compare( bench_src, bench_dest, bench_size ) );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(memcmp_words_bench)
+   bench_do_not_optimize( mem::compare( bench_src, bench_dest, bench_size ) );
+EOSIO_BENCH_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(memory_test);
+
+   bench_parse_args(argc, argv);
+   pattern( bench_src, sizeof(bench_src), 5 );
+   EOSIO_BENCH(memcpy_bytes_bench);
+   EOSIO_BENCH(memcpy_words_bench);
+   EOSIO_BENCH(memset_bytes_bench);
+   EOSIO_BENCH(memset_words_bench);
+   byte_copy( bench_dest, bench_src, sizeof(bench_dest) );
+   EOSIO_BENCH(memcmp_bytes_bench);
+   EOSIO_BENCH(memcmp_words_bench);
+   return has_failed();
+}
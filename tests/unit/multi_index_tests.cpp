@@ -0,0 +1,443 @@
+/**
+ *  @file
+ *  @copyright defined in eosio.cdt/LICENSE.txt
+ */
+
+#include <string>
+#include <vector>
+
+#include <eosio/tester.hpp>
+#include <eosio/db.h>
+#include <eosio/memory_db.hpp>
+#include <eosio/multi_index.hpp>
+#include <eosio/name.hpp>
+
+using std::string;
+using std::vector;
+
+using eosio::const_mem_fun;
+using eosio::indexed_by;
+using eosio::multi_index;
+using eosio::name;
+using eosio::native::memory_db;
+
+struct cached_row {
+   uint64_t id;
+};
+
+using row_cache = eosio::_multi_index_detail::row_cache<cached_row>;
+
+struct item_row {
+   uint64_t id;
+   name     owner;
+   string   memo;
+
+   uint64_t primary_key()const { return id; }
+   uint64_t by_owner()const { return owner.value; }
+
+   EOSLIB_SERIALIZE( item_row, (id)(owner)(memo) )
+};
+
+using items = multi_index<"items"_n, item_row,
+   indexed_by<"byowner"_n, const_mem_fun<item_row, uint64_t, &item_row::by_owner>>
+>;
+
+struct blob_row {
+   uint64_t         id;
+   vector<uint64_t> values;
+   string           memo;
+
+   uint64_t primary_key()const { return id; }
+
+   EOSLIB_SERIALIZE( blob_row, (id)(values)(memo) )
+};
+
+using blobs = multi_index<"blobs"_n, blob_row>;
+
+template<typename View, typename = void>
+struct reads_memo : std::false_type {};
+
+template<typename View>
+struct reads_memo<View, std::void_t<decltype( std::declval<View>().get( &item_row::memo ) )>> : std::true_type {};
+
+// fields may point into the view, so they can only be read from a named one
+static_assert( reads_memo<items::row_view&>::value );
+static_assert( !reads_memo<items::row_view>::value );
+
+static void fill_items( items& table, uint64_t first, uint64_t last, uint64_t step = 1 ) {
+   for ( uint64_t id = first; id <= last; id += step )
+      table.emplace( "code"_n, [&]( auto& row ) {
+         row.id    = id;
+         row.owner = name{ id % 3 };
+         row.memo  = "row";
+      });
+}
+
+template<typename Range>
+static vector<uint64_t> ids_of( Range&& range ) {
+   vector<uint64_t> ids;
+   for ( const auto& row : range )
+      ids.push_back( row.id );
+   return ids;
+}
+
+// home bucket of a key in a cache of 16 buckets, the size of a new cache
+static size_t home_bucket( uint64_t key ) {
+   return size_t((key * 0x9E3779B97F4A7C15ULL) >> 32) & 15;
+}
+
+// Definitions in `eosio.cdt/libraries/eosiolib/contracts/eosio/multi_index.hpp`
+EOSIO_TEST_BEGIN(row_cache_test)
+   silence_output(true);
+
+   //// Item& insert(item_ptr&&, uint64_t, int32_t)
+   //// Item* find_by_primary_key(uint64_t)const
+   //// Item* find_by_primary_iterator(int32_t)const
+   row_cache cache;
+   CHECK_EQUAL( cache.find_by_primary_key( 1 ), nullptr )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 0 ), nullptr )
+
+   cached_row& first = cache.insert( row_cache::item_ptr( new cached_row{ 1 } ), 1, 10 );
+   CHECK_EQUAL( first.id, 1 )
+   CHECK_EQUAL( cache.find_by_primary_key( 1 ), &first )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 10 ), &first )
+   CHECK_EQUAL( cache.find_by_primary_key( 2 ), nullptr )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 1 ), nullptr )
+   CHECK_EQUAL( cache.size(), 1 )
+
+   // a row cached twice would orphan the first entry
+   CHECK_ASSERT( "row is already cached", [&]() { cache.insert( row_cache::item_ptr( new cached_row{ 1 } ), 1, 11 ); } )
+   CHECK_ASSERT( "row is already cached", [&]() { cache.insert( row_cache::item_ptr( new cached_row{ 2 } ), 2, 10 ); } )
+
+   //// bool erase(uint64_t)
+   CHECK_EQUAL( cache.erase( 2 ), false )
+   CHECK_EQUAL( cache.erase( 1 ), true )
+   CHECK_EQUAL( cache.erase( 1 ), false )
+   CHECK_EQUAL( cache.find_by_primary_key( 1 ), nullptr )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 10 ), nullptr )
+   CHECK_EQUAL( cache.size(), 0 )
+
+   // erasing from the middle of a probe chain keeps the rows after it reachable
+   vector<uint64_t> chain;
+   for ( uint64_t key = 100; chain.size() < 3; key++ )
+      if ( home_bucket( key ) == home_bucket( 100 ) )
+         chain.push_back( key );
+   for ( size_t i = 0; i < chain.size(); i++ )
+      cache.insert( row_cache::item_ptr( new cached_row{ chain[i] } ), chain[i], int32_t(i) );
+
+   CHECK_EQUAL( cache.erase( chain[1] ), true )
+   CHECK_EQUAL( cache.find_by_primary_key( chain[1] ), nullptr )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 1 ), nullptr )
+   CHECK_EQUAL( cache.find_by_primary_key( chain[0] )->id, chain[0] )
+   CHECK_EQUAL( cache.find_by_primary_key( chain[2] )->id, chain[2] )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 0 )->id, chain[0] )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 2 )->id, chain[2] )
+
+   // a row erased from the cache can be cached again
+   cache.insert( row_cache::item_ptr( new cached_row{ chain[1] } ), chain[1], 1 );
+   CHECK_EQUAL( cache.find_by_primary_key( chain[1] )->id, chain[1] )
+   CHECK_EQUAL( cache.find_by_primary_iterator( 1 )->id, chain[1] )
+   CHECK_EQUAL( cache.size(), 3 )
+
+   //// void for_each(F&&)const
+   uint64_t sum = 0;
+   cache.for_each( [&]( const cached_row& r ) { sum += r.id; } );
+   CHECK_EQUAL( sum, chain[0] + chain[1] + chain[2] )
+
+   // growing the table rehashes every row
+   row_cache grown;
+   for ( uint64_t key = 0; key < 1000; key++ )
+      grown.insert( row_cache::item_ptr( new cached_row{ key * 7 } ), key * 7, int32_t(key) );
+   CHECK_EQUAL( grown.size(), 1000 )
+   bool all_found = true;
+   for ( uint64_t key = 0; key < 1000; key++ ) {
+      all_found &= grown.find_by_primary_key( key * 7 ) == grown.find_by_primary_iterator( int32_t(key) );
+      all_found &= grown.find_by_primary_key( key * 7 ) != nullptr && grown.find_by_primary_key( key * 7 )->id == key * 7;
+   }
+   CHECK_EQUAL( all_found, true )
+
+   // erasing every other row moves the last entries without losing them
+   for ( uint64_t key = 0; key < 1000; key += 2 )
+      CHECK_EQUAL( grown.erase( key * 7 ), true )
+   CHECK_EQUAL( grown.size(), 500 )
+   bool erased_ok = true;
+   for ( uint64_t key = 0; key < 1000; key++ ) {
+      const cached_row* r = grown.find_by_primary_key( key * 7 );
+      erased_ok &= key % 2 ? (r != nullptr && r->id == key * 7 && r == grown.find_by_primary_iterator( int32_t(key) ))
+                           : (r == nullptr && grown.find_by_primary_iterator( int32_t(key) ) == nullptr);
+   }
+   CHECK_EQUAL( erased_ok, true )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosiolib/contracts/eosio/multi_index.hpp`
+EOSIO_TEST_BEGIN(multi_index_scan_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   //// scan_range scan(uint64_t, uint64_t)const
+   items empty( "code"_n, "empty"_n.value );
+   CHECK_EQUAL( ids_of( empty.scan() ).empty(), true )
+   CHECK_EQUAL( ids_of( empty.scan( 5, 10 ) ).empty(), true )
+
+   items writer( "code"_n, "scan"_n.value );
+   fill_items( writer, 10, 100, 10 );
+
+   // rows are read through a separate table, so none of them are cached
+   items table( "code"_n, "scan"_n.value );
+   CHECK_EQUAL( ids_of( table.scan() ), (vector<uint64_t>{ 10, 20, 30, 40, 50, 60, 70, 80, 90, 100 }) )
+   CHECK_EQUAL( ids_of( table.scan( 25, 55 ) ), (vector<uint64_t>{ 30, 40, 50 }) )
+   CHECK_EQUAL( ids_of( table.scan( 30, 50 ) ), (vector<uint64_t>{ 30, 40, 50 }) )
+   CHECK_EQUAL( ids_of( table.scan( 31, 39 ) ).empty(), true )
+   CHECK_EQUAL( ids_of( table.scan( 100, 100 ) ), (vector<uint64_t>{ 100 }) )
+   CHECK_EQUAL( ids_of( table.scan( 101 ) ).empty(), true )
+   CHECK_EQUAL( ids_of( table.scan( 60, 40 ) ).empty(), true )
+
+   auto once = table.scan();
+   ids_of( once );
+   CHECK_ASSERT( "scan_range can only be iterated once", [&]() { once.begin(); } )
+
+   // rows changed through the cache while the scan runs are yielded as changed
+   vector<string> memos;
+   for ( const auto& row : table.scan() ) {
+      if ( row.id == 30 )
+         table.modify( table.get( 50 ), "code"_n, []( auto& r ) { r.memo = "changed"; } );
+      memos.push_back( row.memo );
+   }
+   CHECK_EQUAL( memos[2], "row" )
+   CHECK_EQUAL( memos[4], "changed" )
+   CHECK_EQUAL( table.get( 50 ).memo, "changed" )
+
+   // rows that were not cached belong to no table
+   items reader( "code"_n, "scan"_n.value );
+   auto uncached = reader.scan( 20, 20 );
+   const item_row& row = *uncached.begin();
+   CHECK_ASSERT( "object passed to modify is not in multi_index", [&]() { reader.modify( row, "code"_n, []( auto& ) {} ); } )
+   CHECK_ASSERT( "object passed to erase is not in multi_index", [&]() { reader.erase( row ); } )
+   CHECK_ASSERT( "object passed to iterator_to is not in multi_index", [&]() { reader.iterator_to( row ); } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosiolib/contracts/eosio/multi_index.hpp`
+EOSIO_TEST_BEGIN(multi_index_row_view_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   items writer( "code"_n, "views"_n.value );
+   fill_items( writer, 1, 3 );
+   writer.modify( writer.get( 2 ), "code"_n, []( auto& row ) { row.memo = "second"; } );
+
+   //// row_view find_view(uint64_t)const
+   //// _multi_index_detail::field_view_type<Field> get(Field T::*)const&
+   items table( "code"_n, "views"_n.value );
+   const auto missing = table.find_view( 4 );
+   CHECK_EQUAL( bool(missing), false )
+   CHECK_ASSERT( "cannot read from an empty row_view", [&]() { missing.get( &item_row::id ); } )
+   CHECK_ASSERT( "cannot read from an empty row_view", [&]() { missing.unpack(); } )
+
+   const auto view = table.find_view( 2 );
+   CHECK_EQUAL( bool(view), true )
+   CHECK_EQUAL( view.get( &item_row::id ), 2 )
+   CHECK_EQUAL( view.get( &item_row::owner ), name{ 2 } )
+   CHECK_EQUAL( view.get( &item_row::memo ), "second" )
+   CHECK_EQUAL( view.size(), eosio::pack_size( table.get( 2 ) ) )
+
+   //// T unpack()const
+   const item_row row = view.unpack();
+   CHECK_EQUAL( row.id, 2 )
+   CHECK_EQUAL( row.memo, "second" )
+
+   //// row_view get_view(uint64_t, const char*)const
+   CHECK_ASSERT( "unable to find key", [&]() { table.get_view( 4 ); } )
+   CHECK_ASSERT( "no row 5", [&]() { table.get_view( 5, "no row 5" ); } )
+   const auto first = table.get_view( 1 );
+   CHECK_EQUAL( first.get( &item_row::memo ), "row" )
+
+   //// row_view find_view(uint64_t, std::vector<char>&)const
+   //// row_view get_view(uint64_t, std::vector<char>&, const char*)const
+   // views over buffers of their own stay valid together
+   vector<char> first_buffer, third_buffer;
+   const auto one   = table.find_view( 1, first_buffer );
+   const auto three = table.get_view( 3, third_buffer );
+   table.find_view( 2 );
+   CHECK_EQUAL( one.get( &item_row::id ), 1 )
+   CHECK_EQUAL( three.get( &item_row::id ), 3 )
+   CHECK_EQUAL( one.data(), first_buffer.data() )
+
+   // reusing a buffer does not shrink it
+   const size_t capacity = third_buffer.size();
+   table.find_view( 1, third_buffer );
+   CHECK_EQUAL( third_buffer.size(), capacity )
+
+   // views do not add rows to the cache
+   CHECK_EQUAL( table.find_view( 3 ).size() > 0, true )
+   uint64_t visited = 0;
+   for ( const auto& r : table.scan() )
+      visited += r.id;
+   CHECK_EQUAL( visited, 6 )
+
+   // primitive vectors are read in place, and a length past the end of the row is rejected
+   blobs blob_table( "code"_n, "views"_n.value );
+   blob_table.emplace( "code"_n, []( auto& r ) { r.id = 1; r.values = { 5, 6, 7 }; r.memo = "blob"; } );
+   const auto blob = blob_table.get_view( 1 );
+   const auto values = blob.get( &blob_row::values );
+   CHECK_EQUAL( values.size(), 3 )
+   CHECK_EQUAL( values[2], 7 )
+   CHECK_EQUAL( blob.get( &blob_row::memo ), "blob" )
+
+   // id 2, then a vector of 0x20000000 elements, whose size in bytes wraps to 0 in 32 bits
+   const char truncated[] = { 2, 0, 0, 0, 0, 0, 0, 0, '\x80', '\x80', '\x80', '\x80', 0x02, 0 };
+   db_store_i64( "views"_n.value, "blobs"_n.value, "code"_n.value, 2, truncated, sizeof(truncated) );
+   const auto bad = blob_table.get_view( 2 );
+   CHECK_EQUAL( bad.get( &blob_row::id ), 2 )
+   CHECK_ASSERT( "read", [&]() { bad.get( &blob_row::values ); } )
+   CHECK_ASSERT( "read", [&]() { bad.get( &blob_row::memo ); } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosiolib/contracts/eosio/multi_index.hpp`
+EOSIO_TEST_BEGIN(multi_index_emplace_many_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   //// void emplace_many(name, const Range&, Lambda&&)
+   // every call constructs its rows in a block of its own
+   items table( "code"_n, "bulk"_n.value );
+   const auto constructor = []( auto& row, uint64_t id ) {
+      row.id    = id;
+      row.owner = name{ id % 3 };
+      row.memo  = string( 32, char('a' + id % 26) );
+   };
+   vector<uint64_t> ids;
+   for ( uint64_t block = 0; block < 4; block++ ) {
+      ids.clear();
+      for ( uint64_t id = block * 25; id < (block + 1) * 25; id++ )
+         ids.push_back( id );
+      table.emplace_many( "code"_n, ids, constructor );
+   }
+   table.emplace_many( "code"_n, vector<uint64_t>{}, constructor );
+
+   CHECK_EQUAL( table.get( 0 ).memo, string( 32, 'a' ) )
+   CHECK_EQUAL( table.get( 99 ).owner, name{ 0 } )
+   CHECK_EQUAL( table.available_primary_key(), 100 )
+
+   // erase rows spread over every block, then look them up again
+   for ( uint64_t id = 0; id < 100; id += 10 )
+      table.erase( table.get( id ) );
+   CHECK_EQUAL( table.find( 10 ) == table.end(), true )
+   CHECK_EQUAL( table.find( 90 ) == table.end(), true )
+   CHECK_EQUAL( table.get( 11 ).memo, string( 32, 'l' ) )
+   CHECK_EQUAL( table.get( 99 ).id, 99 )
+
+   // the rows and their secondary keys were written through
+   items reader( "code"_n, "bulk"_n.value );
+   CHECK_EQUAL( ids_of( reader.scan() ).size(), 90 )
+   size_t per_owner[3] = {};
+   const auto& by_owner = reader.get_index<"byowner"_n>();
+   for ( auto it = by_owner.begin(); it != by_owner.end(); ++it )
+      per_owner[it->owner.value]++;
+   CHECK_EQUAL( per_owner[0], 30 )
+   CHECK_EQUAL( per_owner[1], 30 )
+   CHECK_EQUAL( per_owner[2], 30 )
+   CHECK_EQUAL( by_owner.find( 1 )->id, 1 )
+
+   // pooled rows can be modified and replaced by rows emplaced one at a time
+   table.modify( table.get( 55 ), "code"_n, []( auto& row ) { row.owner = name{ 7 }; } );
+   table.emplace( "code"_n, [&]( auto& row ) { constructor( row, 10 ); } );
+   CHECK_EQUAL( table.get( 10 ).owner, name{ 1 } )
+   CHECK_EQUAL( items( "code"_n, "bulk"_n.value ).get_index<"byowner"_n>().find( 7 )->id, 55 )
+
+   // pooled rows move with their blocks and are destroyed before them when assigned over
+   const item_row* pooled = &table.get( 56 );
+   items moved( std::move(table) );
+   CHECK_EQUAL( &moved.get( 56 ), pooled )
+   items target( "code"_n, "target"_n.value );
+   target.emplace_many( "code"_n, vector<uint64_t>{ 1, 2, 3 }, constructor );
+   target = std::move(moved);
+   CHECK_EQUAL( &target.get( 56 ), pooled )
+   CHECK_EQUAL( target.get( 57 ).memo, string( 32, 'f' ) )
+   CHECK_EQUAL( items( "code"_n, "target"_n.value ).get( 3 ).memo, string( 32, 'd' ) )
+   table = std::move(target);
+
+   CHECK_ASSERT( "could not insert object, most likely a uniqueness constraint was violated", [&]() {
+      table.emplace_many( "code"_n, vector<uint64_t>{ 200, 11 }, constructor );
+   })
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/eosiolib/contracts/eosio/multi_index.hpp`
+EOSIO_TEST_BEGIN(multi_index_keys_test)
+   silence_output(true);
+   memory_db::clear();
+   memory_db::set_receiver( "code"_n );
+
+   const auto primary_keys = []( const auto& range ) {
+      vector<uint64_t> ids;
+      for ( const auto& entry : range )
+         ids.push_back( entry.primary_key() );
+      return ids;
+   };
+
+   //// key_range keys()const
+   //// key_range keys(const secondary_key_type&, const secondary_key_type&)const
+   //// size_t count_range(const secondary_key_type&, const secondary_key_type&)const
+   items empty( "code"_n, "nokeys"_n.value );
+   const auto& empty_owners = empty.get_index<"byowner"_n>();
+   CHECK_EQUAL( primary_keys( empty_owners.keys() ).empty(), true )
+   CHECK_EQUAL( primary_keys( empty_owners.keys( 0, 10 ) ).empty(), true )
+   CHECK_EQUAL( empty_owners.count_range( 0, std::numeric_limits<uint64_t>::max() ), 0 )
+
+   // a table whose rows were all erased is empty as well
+   fill_items( empty, 1, 1 );
+   empty.erase( empty.get( 1 ) );
+   CHECK_EQUAL( primary_keys( empty_owners.keys() ).empty(), true )
+   CHECK_EQUAL( empty_owners.count_range( 0, std::numeric_limits<uint64_t>::max() ), 0 )
+
+   // owners 0, 1 and 2 are each shared by several rows, the last row has the highest key
+   items table( "code"_n, "keys"_n.value );
+   fill_items( table, 1, 9 );
+   table.emplace( "code"_n, []( auto& row ) { row.id = 10; row.owner = name{ std::numeric_limits<uint64_t>::max() }; } );
+   const auto& owners = table.get_index<"byowner"_n>();
+
+   CHECK_EQUAL( primary_keys( owners.keys() ), (vector<uint64_t>{ 3, 6, 9, 1, 4, 7, 2, 5, 8, 10 }) )
+   CHECK_EQUAL( primary_keys( owners.keys( 1, 1 ) ), (vector<uint64_t>{ 1, 4, 7 }) )
+   CHECK_EQUAL( primary_keys( owners.keys( 1, 2 ) ), (vector<uint64_t>{ 1, 4, 7, 2, 5, 8 }) )
+   CHECK_EQUAL( primary_keys( owners.keys( 3, 1000 ) ).empty(), true )
+   CHECK_EQUAL( owners.count_range( 0, 0 ), 3 )
+   CHECK_EQUAL( owners.count_range( 2, std::numeric_limits<uint64_t>::max() ), 4 )
+   CHECK_EQUAL( owners.count_range( std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max() ), 1 )
+   CHECK_EQUAL( owners.count_range( 0, std::numeric_limits<uint64_t>::max() ), 10 )
+
+   CHECK_ASSERT( "invalid secondary key range", [&]() { owners.keys( 2, 1 ); } )
+   CHECK_ASSERT( "invalid secondary key range", [&]() { owners.count_range( 2, 1 ); } )
+
+   // secondary keys and rows are read on demand, duplicates included
+   vector<uint64_t> secondary;
+   for ( const auto& entry : owners.keys( 1, 2 ) )
+      secondary.push_back( entry.secondary_key() );
+   CHECK_EQUAL( secondary, (vector<uint64_t>{ 1, 1, 1, 2, 2, 2 }) )
+   const auto range = owners.keys( 2, 2 );
+   auto it = range.begin();
+   CHECK_EQUAL( (it++)->row().memo, "row" )
+   CHECK_EQUAL( it->row().id, 5 )
+   CHECK_EQUAL( &it->row(), &table.get( 5 ) )
+   CHECK_ASSERT( "cannot increment end iterator", [&]() { auto e = range.end(); ++e; } )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   EOSIO_TEST(row_cache_test);
+   EOSIO_TEST(multi_index_scan_test);
+   EOSIO_TEST(multi_index_row_view_test);
+   EOSIO_TEST(multi_index_emplace_many_test);
+   EOSIO_TEST(multi_index_keys_test);
+   return has_failed();
+}
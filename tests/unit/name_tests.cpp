@@ -5,14 +5,22 @@
 
 #include <limits>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <eosio/eosio.hpp>
 #include <eosio/tester.hpp>
 
 using std::numeric_limits;
 using std::string;
+using std::string_view;
+using std::vector;
 
+using eosio::is_valid_name;
 using eosio::name;
+using eosio::names_from_string;
+using eosio::names_to_string;
+using eosio::write_names_as_string;
 
 static constexpr uint64_t u64min = numeric_limits<uint64_t>::min(); // 0ULL
 static constexpr uint64_t u64max = numeric_limits<uint64_t>::max(); // 18446744073709551615ULL
@@ -372,7 +380,168 @@ EOSIO_TEST_BEGIN(name_type_test)
    silence_output(false);
 EOSIO_TEST_END
 
+// The character at a time conversions name used before its word parallel ones, kept as the reference
+static const char* reference_charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+
+static bool reference_from_string( string_view str, uint64_t& value ) {
+   value = 0;
+   if( str.size() > 13 )
+      return false;
+   for( size_t i = 0; i < str.size(); ++i ) {
+      const char* c = str[i] ? std::char_traits<char>::find( reference_charmap, 32, str[i] ) : nullptr;
+      if( c == nullptr || (i == 12 && c - reference_charmap > 0x0F) )
+         return false;
+      value |= i < 12 ? uint64_t(c - reference_charmap) << (59 - 5 * i) : uint64_t(c - reference_charmap);
+   }
+   return true;
+}
+
+static string reference_to_string( uint64_t value ) {
+   string str;
+   auto v = value;
+   for( auto i = 0; i < 13 && v != 0; ++i, v <<= 5 )
+      str += reference_charmap[(v & 0xF800000000000000ull) >> (i == 12 ? 60 : 59)];
+   return str;
+}
+
+static uint64_t next_random( uint64_t& x ) {
+   x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+   return x;
+}
+
+// Definitions in `eosio.cdt/libraries/eosio/name.hpp`
+EOSIO_TEST_BEGIN(name_conversion_test)
+   silence_output(true);
+
+   //// constexpr explicit name(std::string_view)
+   //// constexpr bool is_valid_name(std::string_view)
+   // every byte at every position of names of every length
+   size_t mismatches = 0;
+   for( size_t len = 1; len <= 13; ++len ) {
+      for( size_t pos = 0; pos < len; ++pos ) {
+         for( int c = 0; c < 256; ++c ) {
+            string str( len, 'a' );
+            str[pos] = char(c);
+            uint64_t expected = 0;
+            const bool valid = reference_from_string( str, expected );
+            mismatches += is_valid_name( str ) != valid;
+            if( valid )
+               mismatches += name{str}.value != expected;
+         }
+      }
+   }
+   CHECK_EQUAL( mismatches, 0 )
+   CHECK_EQUAL( is_valid_name( "" ), true )
+   CHECK_EQUAL( is_valid_name( "12345abcdefghj" ), false )
+   CHECK_EQUAL( is_valid_name( string_view{"a\0b", 3} ), false )
+
+   //// char* write_as_string(char*, char*)const
+   //// uint8_t length()const
+   // every name of up to two characters, each character at every position, and random values
+   mismatches = 0;
+   for( int a = 0; a < 32; ++a ) {
+      for( int b = 0; b < 32; ++b ) {
+         const string str{reference_charmap[a], reference_charmap[b]};
+         mismatches += name{str}.to_string() != reference_to_string( name{str}.value );
+         mismatches += name{name{str}.to_string()} != name{str};
+      }
+   }
+   for( uint64_t pos = 0; pos < 13; ++pos ) {
+      for( uint64_t v = 0; v < (pos < 12 ? 32 : 16); ++v ) {
+         const name n{pos < 12 ? v << (59 - 5 * pos) : v};
+         mismatches += n.to_string() != reference_to_string( n.value );
+         mismatches += n.length() != reference_to_string( n.value ).size();
+      }
+   }
+   uint64_t x = 88172645463325252ULL;
+   for( int i = 0; i < 100000; ++i ) {
+      const name n{next_random( x ) >> (x % 64)};
+      const string str = n.to_string();
+      mismatches += str != reference_to_string( n.value );
+      mismatches += n.length() != str.size();
+      mismatches += name{str} != n;
+   }
+   CHECK_EQUAL( mismatches, 0 )
+
+   //// char* write_names_as_string(const name*, const name*, char*, char*, char)
+   //// std::string names_to_string(const std::vector<name>&, char)
+   //// std::vector<name> names_from_string(std::string_view, char)
+   const vector<name> names{name{"alice"}, name{}, name{"eosio.token"}, name{"zzzzzzzzzzzzj"}};
+   CHECK_EQUAL( names_to_string( names ), "alice,,eosio.token,zzzzzzzzzzzzj" )
+   CHECK_EQUAL( names_to_string( names, ' ' ), "alice  eosio.token zzzzzzzzzzzzj" )
+   CHECK_EQUAL( names_to_string( {} ), "" )
+   CHECK_EQUAL( (names_from_string( "alice,,eosio.token,zzzzzzzzzzzzj" ) == names), true )
+   CHECK_EQUAL( (names_from_string( "a|b", '|' ) == vector<name>{name{"a"}, name{"b"}}), true )
+   CHECK_EQUAL( names_from_string( "" ).empty(), true )
+   CHECK_EQUAL( names_from_string( "," ).size(), 2 )
+   CHECK_ASSERT( "character is not in allowed character set for names", []() { names_from_string( "alice,Bob" ); } )
+
+   char buffer[14 * 4];
+   CHECK_EQUAL( write_names_as_string( names.data(), names.data() + 4, buffer, buffer + sizeof(buffer) - 1 ), buffer )
+   CHECK_EQUAL( string(buffer, write_names_as_string( names.data(), names.data() + 4, buffer, buffer + sizeof(buffer) )),
+                "alice,,eosio.token,zzzzzzzzzzzzj" )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+static constexpr size_t bench_count = 1024;
+
+static const string* bench_strings() {
+   static string strs[bench_count];
+   static const bool filled = [] {
+      uint64_t x = 88172645463325252ULL;
+      for( size_t i = 0; i < bench_count; ++i )
+         strs[i] = reference_to_string( next_random( x ) & ~0x0Full );
+      return true;
+   }();
+   bench_do_not_optimize( filled );
+   return strs;
+}
+
+static const name* bench_names() {
+   static name names[bench_count];
+   static const bool filled = [] {
+      for( size_t i = 0; i < bench_count; ++i )
+         names[i] = name{bench_strings()[i]};
+      return true;
+   }();
+   bench_do_not_optimize( filled );
+   return names;
+}
+
+// The reference conversions against name's
+EOSIO_BENCH_BEGIN(name_reference_from_string_bench)
+   static size_t i = 0;
+   uint64_t value = 0;
+   bench_do_not_optimize( reference_from_string( bench_strings()[i++ % bench_count], value ) );
+   bench_do_not_optimize( value );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(name_string_ctor_bench)
+   static size_t i = 0;
+   bench_do_not_optimize( name{bench_strings()[i++ % bench_count]} );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(name_reference_to_string_bench)
+   static size_t i = 0;
+   bench_do_not_optimize( reference_to_string( bench_names()[i++ % bench_count].value ) );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(name_write_as_string_bench)
+   static size_t i = 0;
+   char buffer[13];
+   bench_do_not_optimize( bench_names()[i++ % bench_count].write_as_string( buffer, buffer + sizeof(buffer) ) );
+   bench_do_not_optimize( buffer );
+EOSIO_BENCH_END
+
 int main(int argc, char* argv[]) {
    EOSIO_TEST(name_type_test);
+   EOSIO_TEST(name_conversion_test);
+
+   bench_parse_args(argc, argv);
+   EOSIO_BENCH(name_reference_from_string_bench);
+   EOSIO_BENCH(name_string_ctor_bench);
+   EOSIO_BENCH(name_reference_to_string_bench);
+   EOSIO_BENCH(name_write_as_string_bench);
    return has_failed();
 }
@@ -1,5 +1,11 @@
 #include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/crypto.hpp>
 #include <eosio/tester.hpp>
+#include <eosio/time.hpp>
+
+#include <algorithm>
+#include <string>
 
 using namespace eosio::native;
 
@@ -24,7 +30,68 @@ EOSIO_TEST_BEGIN(print_test)
    silence_output(false);
 EOSIO_TEST_END
 
+EOSIO_TEST_BEGIN(print_buffer_test)
+   using eosio::asset;
+   using eosio::name;
+   using eosio::symbol;
+
+   silence_output(false);
+   CHECK_PRINT("alice 1.0000 SYS -42 7 true x", [](){ eosio::print(name{"alice"}, " ", asset{10000, symbol{"SYS", 4}}, " ", -42, " ", (uint8_t)7, " ", true, " ", 'x'); });
+   CHECK_PRINT("-1.5000 SYS", [](){ eosio::print(asset{-15000, symbol{"SYS", 4}}); });
+   CHECK_PRINT("5 EOS", [](){ eosio::print(asset{5, symbol{"EOS", 0}}); });
+   CHECK_PRINT("1.0000 SYS@eosio.token", [](){ eosio::print(eosio::extended_asset{asset{10000, symbol{"SYS", 4}}, name{"eosio.token"}}); });
+   CHECK_PRINT("4,SYS@eosio.token", [](){ eosio::print(eosio::extended_symbol{symbol{"SYS", 4}, name{"eosio.token"}}); });
+   CHECK_PRINT("4,SYS SYS", [](){ eosio::print(symbol{"SYS", 4}, " ", symbol{"SYS", 4}.code()); });
+   CHECK_PRINT("1970-01-01T00:00:00.000", [](){ eosio::print(eosio::time_point{}); });
+   CHECK_PRINT("1969-12-31T23:59:59.999", [](){ eosio::print(eosio::time_point{eosio::microseconds{-1}}); });
+   CHECK_PRINT("2024-02-29T12:34:56.789", [](){ eosio::print(eosio::time_point{eosio::microseconds{1709210096789000ll}}); });
+   CHECK_PRINT("2106-02-07T06:28:15", [](){ eosio::print(eosio::time_point_sec{0xffffffff}); });
+   CHECK_PRINT("2000-01-01T00:00:00.500", [](){ eosio::print(eosio::block_timestamp{1}); });
+   CHECK_PRINT("0000000000000000000000000000000000000000|", [](){ eosio::print(eosio::checksum160{}, "|"); });
+   CHECK_PRINT("a=1 b=bob c=%", [](){ eosio::print_f("a=% b=% c=%", 1, name{"bob"}); });
+   silence_output(false);
+EOSIO_TEST_END
+
+// Definitions in `eosio.cdt/libraries/native/crt.cpp`
+EOSIO_TEST_BEGIN(output_capture_test)
+   silence_output(true);
+
+   // output longer than the inline buffer moves to the heap
+   const std::string line(100, 'x');
+   CHECK_PRINT([&](const std::string& out) {
+      return out.size() == 100 * 100 && std::count(out.begin(), out.end(), 'x') == 100 * 100 && !std_out.overflowed;
+   }, [&]() {
+      for (int i = 0; i < 100; i++)
+         eosio::print(line);
+   });
+
+   // a capture stops at max_capacity instead of writing past its buffer
+   eosio::cdt::output_stream capture{};
+   const std::string chunk(1024*1024, 'y');
+   for (size_t i = 0; i < eosio::cdt::output_stream::max_capacity / chunk.size() + 1; i++)
+      capture.append(chunk.c_str(), chunk.size());
+   CHECK_EQUAL( capture.overflowed, true )
+   CHECK_EQUAL( capture.index, eosio::cdt::output_stream::max_capacity - 1 )
+   CHECK_EQUAL( capture.get()[capture.index], '\0' )
+   capture.clear();
+   capture.push('z');
+   CHECK_EQUAL( capture.to_string(), "z" )
+   CHECK_EQUAL( capture.overflowed, false )
+
+   // quiet output drops the prints but still captures the assert messages
+   quiet_output(true);
+   CHECK_PRINT("", [](){ eosio::print("dropped ", 42, " ", eosio::name{"alice"}); });
+   CHECK_PRINT("", [](){ eosio::print(1.5); });
+   CHECK_ASSERT("still captured", [](){ eosio::check(false, "still captured"); });
+   quiet_output(false);
+   CHECK_PRINT("printed", [](){ eosio::print("printed"); });
+
+   silence_output(false);
+EOSIO_TEST_END
+
 int main(int argc, char** argv) {
    EOSIO_TEST(print_test);
+   EOSIO_TEST(print_buffer_test);
+   EOSIO_TEST(output_capture_test);
    return has_failed();
 }
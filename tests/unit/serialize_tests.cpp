@@ -22,6 +22,8 @@ using std::tie;
 using std::vector;
 
 using eosio::datastream;
+using eosio::fixed_pack_size_v;
+using eosio::has_fixed_pack_size_v;
 
 struct B {
    const char c{};
@@ -105,7 +107,26 @@ EOSIO_TEST_BEGIN(serialize_test)
    silence_output(false);
 EOSIO_TEST_END
 
+// Definitions in `eosio.cdt/libraries/eosio/serialize.hpp`
+EOSIO_TEST_BEGIN(fixed_pack_size_test)
+   silence_output(true);
+
+   // EOSLIB_SERIALIZE and EOSLIB_SERIALIZE_DERIVED expose the size of the listed members
+   static_assert( fixed_pack_size_v<B> == sizeof(char) );
+   static_assert( fixed_pack_size_v<D1> == sizeof(char) + sizeof(int) );
+   CHECK_EQUAL( has_fixed_pack_size_v<D2>, false )
+
+   static constexpr D1 d1{'c', 42};
+   const vector<char> packed = eosio::pack( d1 );
+   CHECK_EQUAL( packed.size(), fixed_pack_size_v<D1> )
+   CHECK_EQUAL( packed[0], 'c' )
+   CHECK_EQUAL( (eosio::unpack<D1>( packed ) == d1), true )
+
+   silence_output(false);
+EOSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    EOSIO_TEST(serialize_test)
+   EOSIO_TEST(fixed_pack_size_test)
    return has_failed();
 }
@@ -198,12 +198,21 @@ EOSIO_TEST_BEGIN(symbol_type_test)
    
    // ---------------------
    // void print(bool)const
-   // Note:
-   // This function prints the length of the symbol at the very end
-   CHECK_PRINT( "0,A1", [&](){symbol{"A", 0}.print(true);} );
-   CHECK_PRINT( "0,Z1", [&](){symbol{"Z", 0}.print(true);} );
-   CHECK_PRINT( "255,AAAAAAA7", [&](){symbol{"AAAAAAA", 255}.print(true);} );
-   CHECK_PRINT( "255,ZZZZZZZ7", [&](){symbol{"ZZZZZZZ", 255}.print(true);} );
+   CHECK_PRINT( "0,A", [&](){symbol{"A", 0}.print(true);} );
+   CHECK_PRINT( "0,Z", [&](){symbol{"Z", 0}.print(true);} );
+   CHECK_PRINT( "255,AAAAAAA", [&](){symbol{"AAAAAAA", 255}.print(true);} );
+   CHECK_PRINT( "255,ZZZZZZZ", [&](){symbol{"ZZZZZZZ", 255}.print(true);} );
+   CHECK_PRINT( "ZZZZZZZ", [&](){symbol{"ZZZZZZZ", 255}.print(false);} );
+
+   // ---------------------------------------------
+   // char* write_as_string(char*, char*, bool)const
+   // string to_string(bool)const
+   CHECK_EQUAL( (symbol{"A", 0}.to_string()), "0,A" )
+   CHECK_EQUAL( (symbol{"ZZZZZZZ", 255}.to_string()), "255,ZZZZZZZ" )
+   CHECK_EQUAL( (symbol{"SYS", 4}.to_string(false)), "SYS" )
+   char sym_buffer[11];
+   CHECK_EQUAL( (symbol{"SYS", 4}.write_as_string( sym_buffer, sym_buffer + 10 ) == sym_buffer), true )
+   CHECK_EQUAL( (symbol{"SYS", 4}.write_as_string( sym_buffer, sym_buffer + 11 ) == sym_buffer + 5), true )
 
    // --------------------------------------------------------------
    // friend constexpr bool operator==(const symbol&, const symbol&)
@@ -273,16 +282,14 @@ EOSIO_TEST_BEGIN(extended_symbol_type_test)
    
    // ---------------------
    // void print(bool)const
-   // Note:
-   // Uncomment once print checking has been resolved
-   // CHECK_PRINT( "0,A@1", [&](){extended_symbol{s0, n0}.print(true);} );
-   // CHECK_PRINT( "0,A@5", [&](){extended_symbol{s0, n1}.print(true);} );
-   // CHECK_PRINT( "0,Z@a", [&](){extended_symbol{s1, n2}.print(true);} );
-   // CHECK_PRINT( "0,Z@z", [&](){extended_symbol{s1, n3}.print(true);} );
-   // CHECK_PRINT( "255,AAAAAAA@111111111111j", [&](){extended_symbol{s2, n4}.print(true);} );
-   // CHECK_PRINT( "255,AAAAAAA@555555555555j", [&](){extended_symbol{s2, n5}.print(true);} );
-   // CHECK_PRINT( "255,ZZZZZZZ@aaaaaaaaaaaaj", [&](){extended_symbol{s3, n6}.print(true);} );
-   // CHECK_PRINT( "255,ZZZZZZZ@zzzzzzzzzzzzj", [&](){extended_symbol{s3, n7}.print(true);} );
+   CHECK_PRINT( "0,A@1", [&](){extended_symbol{s0, n0}.print(true);} );
+   CHECK_PRINT( "0,A@5", [&](){extended_symbol{s0, n1}.print(true);} );
+   CHECK_PRINT( "0,Z@a", [&](){extended_symbol{s1, n2}.print(true);} );
+   CHECK_PRINT( "0,Z@z", [&](){extended_symbol{s1, n3}.print(true);} );
+   CHECK_PRINT( "255,AAAAAAA@111111111111j", [&](){extended_symbol{s2, n4}.print(true);} );
+   CHECK_PRINT( "255,AAAAAAA@555555555555j", [&](){extended_symbol{s2, n5}.print(true);} );
+   CHECK_PRINT( "255,ZZZZZZZ@aaaaaaaaaaaaj", [&](){extended_symbol{s3, n6}.print(true);} );
+   CHECK_PRINT( "255,ZZZZZZZ@zzzzzzzzzzzzj", [&](){extended_symbol{s3, n7}.print(true);} );
 
    // -------------------------------------------------------------------------------
    // friend constexpr bool operator==(const extended_symbol&, const extended_symbol&)
@@ -0,0 +1,109 @@
+#include <eosio/eosio.hpp>
+
+using namespace eosio;
+
+// simple macro to add line info to string
+#define STRINGIFY(x) #x
+#define TOSTRING(x) STRINGIFY(x)
+#define X(STR) \
+   STR " at line # " TOSTRING(__LINE__)
+
+// exercises the reuse paths of the size class allocator, linked with --use-size-class-malloc
+CONTRACT scm_malloc_tests : public contract{
+   public:
+      using contract::contract;
+
+      ACTION freelist() {
+         char* ptr1 = (char*)malloc(24);
+         char* ptr2 = (char*)malloc(24);
+         check(ptr1 != nullptr && ptr2 != nullptr, X("should have allocated two 24 char bufs"));
+         check((size_t)ptr1%8 == 0 && (size_t)ptr2%8 == 0, X("blocks should be 8 byte aligned"));
+
+         // 17 to 32 bytes share a class, ptr2 keeps ptr1 from being the top block
+         free(ptr1);
+         char* ptr3 = (char*)malloc(100);
+         check(ptr3 != ptr1, X("a block should only be reused by its own class"));
+         char* ptr4 = (char*)malloc(20);
+         check(ptr4 == ptr1, X("a freed block should be reused by its class"));
+         char* ptr5 = (char*)malloc(30);
+         check(ptr5 != ptr1 && ptr5 != ptr2 && ptr5 != ptr3, X("the free list should be empty again"));
+
+         // blocks are reused most recently freed first
+         free(ptr2);
+         free(ptr4);
+         check((char*)malloc(32) == ptr4, X("should reuse the last freed block first"));
+         check((char*)malloc(17) == ptr2, X("should reuse the other freed block next"));
+      }
+
+      ACTION releasetop() {
+         char* ptr1 = (char*)malloc(40);
+         free(ptr1);
+         // the top block is handed back to the bump region, not to its class
+         char* ptr2 = (char*)malloc(200);
+         check(ptr2 == ptr1, X("the released top block should be carved again"));
+         char* ptr3 = (char*)malloc(40);
+         check(ptr3 > ptr2, X("a later block should be carved after ptr2"));
+         free(ptr3);
+         check((char*)malloc(8) == ptr3, X("the released top block should be carved again"));
+      }
+
+      ACTION realloctop() {
+         char* ptr1 = (char*)malloc(16);
+         for (int i = 0; i < 16; i++)
+            ptr1[i] = char(i);
+
+         check((char*)realloc(ptr1, 12) == ptr1, X("shrinking should keep the block"));
+         char* ptr2 = (char*)realloc(ptr1, 4000);
+         check(ptr2 == ptr1, X("the top block should grow in place"));
+         char* ptr3 = (char*)realloc(ptr2, 3*64*1024);
+         check(ptr3 == ptr1, X("the top block should grow in place across pages"));
+         for (int i = 0; i < 16; i++)
+            check(ptr3[i] == char(i), X("growing in place should keep the contents"));
+         for (int i = 0; i < 3*64*1024; i++)
+            ptr3[i] = 'a';
+
+         // a block below the top moves
+         char* ptr4 = (char*)malloc(16);
+         char* ptr5 = (char*)realloc(ptr3, 5*64*1024);
+         check(ptr5 != ptr3 && ptr5 > ptr4, X("a block below the top should move"));
+         check(ptr5[0] == 'a' && ptr5[3*64*1024-1] == 'a', X("moving should keep the contents"));
+
+         check(realloc(nullptr, 0) == nullptr, X("realloc(nullptr, 0) should not allocate"));
+         check(realloc(ptr4, 0) == nullptr, X("realloc to 0 bytes should free the block"));
+         check((char*)malloc(16) == ptr4, X("the block freed by realloc should be reused"));
+      }
+
+      ACTION hugereuse() {
+         // larger than the biggest class, served exactly
+         const size_t huge = 2*1024*1024;
+         char* ptr1 = (char*)malloc(huge);
+         char* ptr2 = (char*)malloc(16);
+         check(ptr1 != nullptr && ptr2 > ptr1, X("should have allocated a huge buf"));
+         ptr1[huge-1] = 'a';
+
+         free(ptr1);
+         char* ptr3 = (char*)malloc(huge + 8);
+         check(ptr3 != ptr1, X("a smaller free huge block should not be reused"));
+         char* ptr4 = (char*)malloc(huge - 1024);
+         check(ptr4 == ptr1, X("a large enough free huge block should be reused"));
+         check(realloc(ptr4, huge) == ptr4, X("the reused block should keep its capacity"));
+      }
+
+      ACTION calloczero() {
+         char* ptr1 = (char*)malloc(64);
+         char* ptr2 = (char*)malloc(16);
+         for (int i = 0; i < 64; i++)
+            ptr1[i] = char(0xff);
+
+         // calloc reuses the dirty block and clears it
+         free(ptr1);
+         char* ptr3 = (char*)calloc(8, 8);
+         check(ptr3 == ptr1, X("calloc should reuse the freed block"));
+         for (int i = 0; i < 64; i++)
+            check(ptr3[i] == 0, X("calloc should zero the block"));
+
+         check(calloc(0, 8) == nullptr, X("calloc of 0 bytes should not allocate"));
+         check(calloc(size_t(-1) / 2, 4) == nullptr, X("calloc should fail on overflow"));
+         check(ptr2 != nullptr, X("ptr2 should still be allocated"));
+      }
+};
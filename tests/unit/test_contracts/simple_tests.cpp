@@ -61,6 +61,41 @@ class [[eosio::contract]] simple_tests : public contract {
          t.send(nm.value, get_self());
       }
 
+      // arguments decoded in place, then moved, bound by reference or viewed in the action data
+      [[eosio::action]]
+      void byvalue(name nm, std::string memo, std::vector<uint64_t> ids) {
+         check(nm == "bucky"_n, "not bucky");
+         check(memo == "some string", "some string does not match");
+         check(ids == std::vector<uint64_t>{1, 2, 3}, "ids do not match");
+      }
+
+      [[eosio::action]]
+      void byref(const name& nm, const std::string& memo, const std::vector<uint64_t>& ids) {
+         check(nm == "bucky"_n, "not bucky");
+         check(memo == "some string", "some string does not match");
+         check(ids == std::vector<uint64_t>{1, 2, 3}, "ids do not match");
+      }
+
+      [[eosio::action]]
+      void byview(name nm, std::string_view memo, uint32_t count) {
+         check(nm == "bucky"_n, "not bucky");
+         check(memo == "some string", "some string does not match");
+         check(count == 33, "33 does not match");
+      }
+
+      [[eosio::action]]
+      void viewonly(std::string_view memo) {
+         check(memo == "some string", "some string does not match");
+      }
+
+      [[eosio::action]]
+      void bymixed(name nm, const std::string& memo, std::string_view view, std::vector<std::string> moved) {
+         check(nm == "bucky"_n, "not bucky");
+         check(memo == "some string", "some string does not match");
+         check(view == "other string", "other string does not match");
+         check(moved.size() == 2 && moved[1] == "b", "moved strings do not match");
+      }
+
       [[eosio::on_notify("eosio.token::transfer")]] 
       void on_transfer(name from, name to, asset quant, std::string memo) {
          check(get_first_receiver() == "eosio.token"_n, "should be eosio.token");
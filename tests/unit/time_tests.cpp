@@ -208,6 +208,18 @@ EOSIO_TEST_BEGIN(time_point_type_test)
    CHECK_EQUAL( (time_point{ms1} >= time_point{ms1}), true  )
    CHECK_EQUAL( (time_point{ms0} >= time_point{ms1}), false )
 
+   // ------------------------------------
+   // char* write_as_string(char*, char*)const
+   // std::string to_string()const
+   CHECK_EQUAL( time_point{ms0}.to_string(), "1970-01-01T00:00:00.000" )
+   CHECK_EQUAL( time_point{msn1}.to_string(), "1969-12-31T23:59:59.999" )
+   CHECK_EQUAL( time_point{microseconds{1709210096789999LL}}.to_string(), "2024-02-29T12:34:56.789" )
+   CHECK_EQUAL( time_point{ms_max}.to_string(), "294247-01-10T04:00:54.775" )
+   CHECK_EQUAL( time_point{ms_min}.to_string(), "-290308-12-21T19:59:05.224" )
+   char tp_buffer[26];
+   CHECK_EQUAL( (time_point{ms0}.write_as_string( tp_buffer, tp_buffer + 25 ) == tp_buffer), true )
+   CHECK_EQUAL( (time_point{ms0}.write_as_string( tp_buffer, tp_buffer + 26 ) == tp_buffer + 23), true )
+
    silence_output(false);
 EOSIO_TEST_END
 
@@ -375,6 +387,13 @@ EOSIO_TEST_BEGIN(time_point_sec_type_test)
    CHECK_EQUAL( (time_point_sec{1} >= time_point_sec{1}), true  )
    CHECK_EQUAL( (time_point_sec{1} >= time_point_sec{2}), false )
 
+   // ------------------------------------
+   // char* write_as_string(char*, char*)const
+   // std::string to_string()const
+   CHECK_EQUAL( time_point_sec{u32min}.to_string(), "1970-01-01T00:00:00" )
+   CHECK_EQUAL( time_point_sec{u32max}.to_string(), "2106-02-07T06:28:15" )
+   CHECK_EQUAL( time_point_sec{951782400}.to_string(), "2000-02-29T00:00:00" )
+
    silence_output(false);
 EOSIO_TEST_END
 
@@ -482,6 +501,13 @@ EOSIO_TEST_BEGIN(block_timestamp_type_test)
    // bool operator>=(const block_timestamp&)
    CHECK_EQUAL( block_timestamp{1} >= block_timestamp{1}, true  )
    CHECK_EQUAL( block_timestamp{1} >= block_timestamp{2}, false )
+
+   // ------------------------------------
+   // char* write_as_string(char*, char*)const
+   // std::string to_string()const
+   CHECK_EQUAL( block_timestamp{0}.to_string(), "2000-01-01T00:00:00.000" )
+   CHECK_EQUAL( block_timestamp{1}.to_string(), "2000-01-01T00:00:00.500" )
+   CHECK_EQUAL( block_timestamp{u32max}.to_string(), "2068-01-19T03:14:07.500" )
    
    silence_output(false);
 EOSIO_TEST_END
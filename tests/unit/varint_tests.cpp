@@ -4,14 +4,17 @@
  */
 
 #include <limits>
+#include <vector>
 
 #include <eosio/tester.hpp>
 #include <eosio/datastream.hpp>
 #include <eosio/varint.hpp>
 
 using std::numeric_limits;
+using std::vector;
 
 using eosio::datastream;
+using eosio::pack;
 using eosio::unsigned_int;
 using eosio::signed_int;
 
@@ -260,8 +263,192 @@ EOSIO_TEST_BEGIN(signed_int_type_test)
    silence_output(false);
 EOSIO_TEST_END
 
+// Byte at a time reference codec, the encoding every unsigned_int must match
+static size_t reference_encode( uint32_t val, char* out ) {
+   size_t n = 0;
+   do {
+      uint8_t b = uint8_t(val) & 0x7f;
+      val >>= 7;
+      b |= ((val > 0) << 7);
+      out[n++] = char(b);
+   } while( val );
+   return n;
+}
+
+static uint32_t reference_decode( const char* in, size_t& n ) {
+   uint64_t v = 0; uint8_t by = 0;
+   n = 0;
+   uint8_t b = 0;
+   do {
+      b = uint8_t(in[n++]);
+      v |= uint64_t(b & 0x7f) << by;
+      by += 7;
+   } while( b & 0x80 );
+   return static_cast<uint32_t>(v);
+}
+
+// Values around every change of encoded length
+static vector<uint32_t> boundary_values() {
+   vector<uint32_t> values{0, 1, u32max, u32max - 1};
+   for ( int bits = 7; bits < 32; bits += 7 ) {
+      const uint32_t edge = uint32_t(1) << bits;
+      values.insert( values.end(), {edge - 1, edge, edge + 1} );
+   }
+   for ( uint32_t v = 1; v < 0x10000000; v = v * 3 + 1 )
+      values.push_back( v );
+   return values;
+}
+
+// Defined in `eosio.cdt/libraries/eosio/varint.hpp`
+EOSIO_TEST_BEGIN(varint_codec_test)
+   silence_output(false);
+
+   char buffer[16];
+   char expected[16];
+   bool ok = true;
+   for ( uint32_t v : boundary_values() ) {
+      const size_t n = reference_encode( v, expected );
+
+      // one write of the whole encoding
+      datastream<char*> ds{buffer, sizeof(buffer)};
+      ds << unsigned_int{v};
+      ok &= ds.tellp() == n && memcmp( buffer, expected, n ) == 0;
+
+      // with room for the 5 byte fast path
+      datastream<const char*> rds{buffer, sizeof(buffer)};
+      unsigned_int ui;
+      rds >> ui;
+      ok &= ui.value == v && rds.tellp() == n;
+
+      // with exactly the encoded bytes, the byte at a time path when shorter than 5 bytes
+      datastream<const char*> exact{buffer, n};
+      exact >> ui;
+      ok &= ui.value == v && exact.remaining() == 0;
+
+      // zig-zag
+      const int32_t sv = int32_t(v);
+      datastream<char*> sds{buffer, sizeof(buffer)};
+      sds << signed_int{sv};
+      signed_int si;
+      datastream<const char*> srds{buffer, sizeof(buffer)};
+      srds >> si;
+      ok &= si.value == sv && srds.tellp() == sds.tellp();
+   }
+   CHECK_EQUAL( ok, true )
+
+   // a truncated encoding fails the same way as before
+   buffer[0] = char(0x80);
+   CHECK_ASSERT( "get", ([&]() { datastream<const char*> ds{buffer, 1}; unsigned_int ui; ds >> ui; }) )
+
+   // encodings longer than 5 bytes keep the low 32 bits
+   const char overlong[8]{char(0xff), char(0xff), char(0xff), char(0xff), char(0xff), char(0x80), char(0x01), 0};
+   size_t n = 0;
+   const uint32_t ref = reference_decode( overlong, n );
+   datastream<const char*> lds{overlong, sizeof(overlong)};
+   unsigned_int ui;
+   lds >> ui;
+   CHECK_EQUAL( ui.value, ref )
+   CHECK_EQUAL( lds.tellp(), n )
+
+   // length prefixes of containers
+   CHECK_EQUAL( pack( vector<char>(200) ).size(), 202 )
+
+   silence_output(false);
+EOSIO_TEST_END
+
+// The previous operators, one bounds checked stream call per byte
+template <typename DataStream>
+static void bytewise_write( DataStream& ds, uint32_t val ) {
+   do {
+      uint8_t b = uint8_t(val) & 0x7f;
+      val >>= 7;
+      b |= ((val > 0) << 7);
+      ds.write( (char*)&b, 1 );
+   } while( val );
+}
+
+template <typename DataStream>
+static uint32_t bytewise_read( DataStream& ds ) {
+   uint64_t v = 0; char b = 0; uint8_t by = 0;
+   do {
+      ds.get(b);
+      v |= uint32_t(uint8_t(b) & 0x7f) << by;
+      by += 7;
+   } while( uint8_t(b) & 0x80 );
+   return static_cast<uint32_t>(v);
+}
+
+static constexpr size_t bench_count = 1024;
+
+struct varint_bench_data {
+   uint32_t values[bench_count];
+   char     packed[bench_count * 5];
+   char     out[bench_count * 5];
+};
+
+// Half of the values single byte lengths, the rest spread over all encoded lengths
+static varint_bench_data& bench_data() {
+   static varint_bench_data data = [] {
+      varint_bench_data d{};
+      uint32_t x = 2463534242u;
+      size_t   packed_size = 0;
+      for ( size_t i = 0; i < bench_count; ++i ) {
+         x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+         d.values[i] = x & 1 ? x & 0x7f : x >> (x >> 1) % 5 * 7;
+         packed_size += reference_encode( d.values[i], d.packed + packed_size );
+      }
+      return d;
+   }();
+   return data;
+}
+
+// Byte at a time stream calls against the codec, one operation covers all of the values
+EOSIO_BENCH_BEGIN(varuint32_encode_bytes_bench)
+   auto& data = bench_data();
+   datastream<char*> ds{data.out, sizeof(data.out)};
+   for ( size_t i = 0; i < bench_count; ++i )
+      bytewise_write( ds, data.values[i] );
+   bench_do_not_optimize( data.out );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(varuint32_encode_words_bench)
+   auto& data = bench_data();
+   datastream<char*> ds{data.out, sizeof(data.out)};
+   for ( size_t i = 0; i < bench_count; ++i )
+      ds << unsigned_int{data.values[i]};
+   bench_do_not_optimize( data.out );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(varuint32_decode_bytes_bench)
+   const auto& data = bench_data();
+   datastream<const char*> ds{data.packed, sizeof(data.packed)};
+   uint32_t sum = 0;
+   for ( size_t i = 0; i < bench_count; ++i )
+      sum += bytewise_read( ds );
+   bench_do_not_optimize( sum );
+EOSIO_BENCH_END
+
+EOSIO_BENCH_BEGIN(varuint32_decode_words_bench)
+   const auto& data = bench_data();
+   datastream<const char*> ds{data.packed, sizeof(data.packed)};
+   uint32_t sum = 0;
+   for ( size_t i = 0; i < bench_count; ++i ) {
+      unsigned_int ui;
+      ds >> ui;
+      sum += ui.value;
+   }
+   bench_do_not_optimize( sum );
+EOSIO_BENCH_END
+
 int main(int argc, char* argv[]) {
    EOSIO_TEST(unsigned_int_type_test)
    EOSIO_TEST(signed_int_type_test);
+   EOSIO_TEST(varint_codec_test);
+
+   bench_parse_args(argc, argv);
+   EOSIO_BENCH(varuint32_encode_bytes_bench);
+   EOSIO_BENCH(varuint32_encode_words_bench);
+   EOSIO_BENCH(varuint32_decode_bytes_bench);
+   EOSIO_BENCH(varuint32_decode_words_bench);
    return has_failed();
 }
@@ -251,10 +251,10 @@ namespace eosio { namespace cdt {
          if (!is_builtin_type(translate_type(type))) {
             if (is_aliasing(type))
                add_typedef(type);
-            else if (is_template_specialization(type, {"vector", "set", "deque", "list", "optional", "binary_extension", "ignore"})) {
+            else if (is_template_specialization(type, {"vector", "lazy_vector", "set", "flat_set", "deque", "list", "optional", "binary_extension", "ignore"})) {
                add_type(get_template_argument(type).getAsType());
             }
-            else if (is_template_specialization(type, {"map"}))
+            else if (is_template_specialization(type, {"map", "flat_map"}))
                add_map(type);
             else if (is_template_specialization(type, {"pair"}))
                add_pair(type);
@@ -251,7 +251,11 @@ namespace eosio { namespace cdt {
                ss << "::read_action_data(buff, as);\n";
                ss << "}\n";
                ss << "eosio::datastream<const char*> ds{(char*)buff, as};\n";
-               int i=0;
+               // the arguments are decoded straight into locals of the handler, all at once so the fixed size
+               // leading ones share a single bounds check, then moved into by value parameters and bound
+               // directly to reference parameters, std::string_view parameters point into the action data
+               const auto num_params = decl->parameters().size();
+               size_t i=0;
                for (auto param : decl->parameters()) {
                   clang::LangOptions lang_opts;
                   lang_opts.CPlusPlus = true;
@@ -262,14 +266,27 @@ namespace eosio { namespace cdt {
                   qt.removeLocalRestrict();
                   std::string tn = clang::TypeName::getFullyQualifiedName(qt, *(cg.ast_context), policy);
                   tn = tn == "_Bool" ? "bool" : tn; // TODO look out for more of these oddities
-                  ss << tn << " arg" << i << "; ds >> arg" << i << ";\n";
+                  ss << tn << " arg" << i << ";\n";
                   i++;
                }
+               if (num_params == 1) {
+                  ss << "ds >> arg0;\n";
+               } else if (num_params > 1) {
+                  ss << "{ auto args = std::tie(";
+                  for (size_t arg=0; arg < num_params; arg++)
+                     ss << (arg ? ", " : "") << "arg" << arg;
+                  ss << "); ds >> args; }\n";
+               }
                ss << decl->getParent()->getQualifiedNameAsString() << "{eosio::name{r},eosio::name{c},ds}." << decl->getNameAsString() << "(";
-               for (int i=0; i < decl->parameters().size(); i++) {
-                  ss << "arg" << i;
-                  if (i < decl->parameters().size()-1)
+               i=0;
+               for (auto param : decl->parameters()) {
+                  if (param->getOriginalType()->isLValueReferenceType())
+                     ss << "arg" << i;
+                  else
+                     ss << "std::move(arg" << i << ")";
+                  if (i < num_params-1)
                      ss << ", ";
+                  i++;
                }
                ss << ");";
                ss << "}}\n";
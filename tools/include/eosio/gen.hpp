@@ -401,6 +401,8 @@ struct generation_utils {
          {"unsigned_int", "varuint32"},
          {"signed_int",   "varint32"},
 
+         {"string_view", "string"},
+
          {"block_timestamp", "block_timestamp_type"},
          {"capi_name",    "name"},
          {"capi_public_key", "public_key"},
@@ -461,13 +463,13 @@ struct generation_utils {
          auto t = translate_type(get_template_argument( type ).getAsType());
          return t+"$";
       }
-      else if ( is_template_specialization( type, {"vector", "set", "deque", "list"} ) ) {
+      else if ( is_template_specialization( type, {"vector", "lazy_vector", "set", "flat_set", "deque", "list"} ) ) {
          auto t =translate_type(get_template_argument( type ).getAsType());
          return t=="int8" ? "bytes" : t+"[]";
       }
       else if ( is_template_specialization( type, {"optional"} ) )
          return translate_type(get_template_argument( type ).getAsType())+"?";
-      else if ( is_template_specialization( type, {"map"} )) {
+      else if ( is_template_specialization( type, {"map", "flat_map"} )) {
          auto t0 = translate_type(get_template_argument( type ).getAsType());
          auto t1 = translate_type(get_template_argument( type, 1).getAsType());
          return replace_in_name("pair_" + t0 + "_" + t1 + "[]");